@@ -4,19 +4,74 @@
 #include <util/ArgParse.hpp>
 #include <util/fs/FsUtil.hpp>
 
+#include <chrono>
+
 using namespace hyperion;
 using namespace hyperion::compiler;
 
+// Compiles a synthetic script of `num_statements` branching statements and reports how long baking it takes.
+static int RunBakeBenchmark(Int num_statements)
+{
+    using namespace std::chrono;
+
+    String source = "var x: int = 0;\n";
+
+    for (Int i = 0; i < num_statements; i++) {
+        const String index = String::ToString(i);
+
+        source += "if (x < " + index + ") { x = x + " + index + "; } else { x = x - 1; }\n";
+    }
+
+    const ByteBuffer byte_buffer(source.Size(), source.Data());
+
+    SourceFile source_file("bake_benchmark", byte_buffer.Size());
+    source_file.ReadIntoBuffer(byte_buffer);
+
+    Script script(source_file);
+
+    scriptapi2::Context context;
+
+    const auto compile_start = steady_clock::now();
+
+    if (!script.Compile(context)) {
+        printf("Failed to compile benchmark script\n");
+
+        return 1;
+    }
+
+    const auto bake_start = steady_clock::now();
+
+    script.Bake();
+
+    const auto bake_end = steady_clock::now();
+
+    const double bake_ms = duration<double, std::milli>(bake_end - bake_start).count();
+
+    // time per statement stays flat as long as baking scales linearly
+    printf(
+        "%d statements: compile %.3f ms, bake %.3f ms (%.3f us per statement)\n",
+        num_statements,
+        duration<double, std::milli>(bake_start - compile_start).count(),
+        bake_ms,
+        num_statements > 0 ? bake_ms * 1000.0 / double(num_statements) : 0.0
+    );
+
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     ArgParse arg_parse;
-    arg_parse.Add("input", "i", ArgParse::ARG_FLAGS_REQUIRED, ArgParse::ARGUMENT_TYPE_STRING);
+    arg_parse.Add("input", "i", ArgParse::ARG_FLAGS_NONE, ArgParse::ARGUMENT_TYPE_STRING);
+    arg_parse.Add("bench-bake", "b", ArgParse::ARG_FLAGS_NONE, ArgParse::ARGUMENT_TYPE_INT);
 
     auto parse_result = arg_parse.Parse(argc, argv);
 
-    if (parse_result.ok) {
-        AssertThrow(parse_result["input"].Is<String>());
+    if (parse_result.ok && parse_result["bench-bake"].Is<Int>()) {
+        return RunBakeBenchmark(parse_result["bench-bake"].Get<Int>());
+    }
 
+    if (parse_result.ok && parse_result["input"].Is<String>()) {
         Reader reader;
         FilePath file_path(parse_result["input"].Get<String>());
 
@@ -47,6 +102,7 @@ int main(int argc, char *argv[])
     }
 
     printf("Usage: %s -i <input file>\n", argv[0]);
+    printf("       %s --bench-bake <number of statements>\n", argv[0]);
 
     if (parse_result.message.HasValue()) {
         printf("Error: %s\n", parse_result.message.Get().Data());
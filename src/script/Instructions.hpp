@@ -62,6 +62,7 @@ enum Instructions : hyperion::UInt8
     LOAD_MEM,          // load_mem          [% reg, % src, u8 idx]
     LOAD_MEM_HASH,     // load_mem_hash     [% reg, % src, u32 hash]
     LOAD_ARRAYIDX,     // load_arrayidx     [% reg, % src, % idx]
+    LOAD_ARRAYIDX_UNCHECKED, // load_arrayidx_unchecked [% reg, % src, % idx] - idx is known to be in range
     LOAD_OFFSET_REF,   // load_offset_ref   [% reg, u16 offset]
     LOAD_INDEX_REF,    // load_index_ref    [% reg, u16 idx]
     LOAD_NULL,         // load_null         [% reg]
@@ -85,6 +86,8 @@ enum Instructions : hyperion::UInt8
     MOV_ARRAYIDX,   // mov_arrayidx [% dst_array, u32 dst_idx, %src]
     /* Copy register value to array index held in other register */
     MOV_ARRAYIDX_REG, // mov_arrayidx_reg [% dst_array, % dst_idx, % src]
+    /* Copy register value to array index held in other register, known to be in range */
+    MOV_ARRAYIDX_UNCHECKED, // mov_arrayidx_unchecked [% dst_array, % dst_idx, % src]
     /* Copy register value to another register */
     MOV_REG,        // mov_reg      [% dst, % src]
     /* Check if the object in the register has a member with the hash,
@@ -114,9 +117,8 @@ enum Instructions : hyperion::UInt8
 
     CALL, // call [% reg, u8 nargs]
     RET,  // ret
-
-    BEGIN_TRY, // begin_try [% catch_addr_reg]
-    END_TRY,
+    TAIL_CALL, // tail_call [% reg, u8 nargs, u8 frame_nargs, u16 frame_locals]
+    CALL_NATIVE, // call_native [u16 idx, u8 nargs] - call a function from the native function table
 
     NEW,       // new [% dst, % src_type_reg]
     NEW_ARRAY, // new_array [% dst, u32 size]
@@ -171,6 +173,9 @@ enum Instructions : hyperion::UInt8
 
     CAST_DYNAMIC, // cast_dynamic [% dst, % src] - cast 'src' to dynamic type, the type is stored in the 'dst' register
 
+    /* Suspend the running generator, saving its frame and returning the value in %src */
+    YIELD, // yield [% src]
+
     /* Signifies the end of the stream */
     EXIT = 0xFF
 };
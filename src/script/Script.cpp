@@ -11,6 +11,9 @@
 #include <script/compiler/Compiler.hpp>
 #include <script/compiler/dis/DecompilationUnit.hpp>
 #include <script/compiler/emit/codegen/CodeGenerator.hpp>
+#include <script/compiler/emit/BytecodeOptimizer.hpp>
+#include <script/compiler/Configuration.hpp>
+#include <script/compiler/ImportPreloader.hpp>
 #include <script/compiler/dis/DecompilationUnit.hpp>
 #include <script/compiler/builtins/Builtins.hpp>
 
@@ -19,12 +22,76 @@
 
 #include <script/vm/VM.hpp>
 
+#include <math/MathUtil.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+
 namespace hyperion {
 
+static void CollectExportedSymbolNames(const BytecodeChunk *chunk, Program::ExportedSymbolNames &out)
+{
+    for (const std::unique_ptr<Buildable> &buildable : chunk->buildables) {
+        if (const BytecodeChunk *nested_chunk = dynamic_cast<const BytecodeChunk *>(buildable.get())) {
+            CollectExportedSymbolNames(nested_chunk, out);
+        } else if (const SymbolExport *symbol_export = dynamic_cast<const SymbolExport *>(buildable.get())) {
+            out.Set(hash_fnv_1(symbol_export->name.Data()), symbol_export->name);
+        }
+    }
+}
+
+// Reads the whole file at the path, returning false if it cannot be opened.
+static bool ReadSourceFile(const String &filepath, SourceFile &out_source_file)
+{
+    std::ifstream file(filepath.Data(), std::ios::in | std::ios::binary | std::ios::ate);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const SizeType size = SizeType(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    ByteBuffer temp;
+    temp.SetSize(size);
+
+    file.read(reinterpret_cast<char *>(temp.Data()), size);
+
+    out_source_file = SourceFile(filepath, size);
+    out_source_file.ReadIntoBuffer(temp);
+
+    return true;
+}
+
+// True if the file can no longer be read, or its contents no longer have the given hash.
+static bool HasSourceChanged(const String &filepath, HashCode::ValueType content_hash)
+{
+    SourceFile source_file;
+
+    return !ReadSourceFile(filepath, source_file)
+        || source_file.GetBuffer().GetHashCode().Value() != content_hash;
+}
+
 Script::Script(const SourceFile &source_file)
     : m_api_instance(source_file),
       m_vm(m_api_instance),
-      m_source_file(source_file)
+      m_source_file(source_file),
+      m_source_hash(0),
+      m_compilation_unit(new CompilationUnit())
+{
+}
+
+Script::Script(const SourceFile &source_file, const RC<Program> &program)
+    : m_api_instance(source_file),
+      m_source_file(source_file),
+      m_source_hash(0),
+      m_compilation_unit(new CompilationUnit()),
+      m_program(program),
+      m_vm(m_api_instance, program->GetNumStaticObjects()),
+      m_bs(program)
 {
 }
 
@@ -41,32 +108,43 @@ bool Script::Compile(scriptapi2::Context &context)
         return false;
     }
 
+    m_source_hash = m_source_file.GetBuffer().GetHashCode().Value();
+    m_compilation_unit->SetParseCache(&m_parse_cache);
+
     SourceStream source_stream(&m_source_file);
 
     TokenStream token_stream(TokenStreamInfo {
         m_source_file.GetFilePath()
     });
 
-    Lexer lex(source_stream, &token_stream, &m_compilation_unit);
+    Lexer lex(source_stream, &token_stream, m_compilation_unit.Get());
     lex.Analyze();
 
     AstIterator ast_iterator;
 
-    SemanticAnalyzer semantic_analyzer(&ast_iterator, &m_compilation_unit);
+    SemanticAnalyzer semantic_analyzer(&ast_iterator, m_compilation_unit.Get());
+
+    m_compilation_unit->GetBuiltins().Visit(&semantic_analyzer);
 
-    m_compilation_unit.GetBuiltins().Visit(&semantic_analyzer);
+    // Generate script bindings into our Context for our C++ classes,
+    // parsing binding signatures only the first time the Context is used
+    context.BuildPrelude();
 
-    // Generate script bindings into our Context for our C++ classes
-    g_script_bindings.GenerateAll(context);
+    context.Visit(&semantic_analyzer, m_compilation_unit.Get(), m_prelude_declarations);
 
-    context.Visit(&semantic_analyzer, &m_compilation_unit);
+    // nodes created from here on belong to this script only, so they can go in its arena
+    AstNodeArena::Scope ast_node_arena_scope(m_compilation_unit->GetAstNodeArena());
 
-    Parser parser(&ast_iterator, &token_stream, &m_compilation_unit);
+    Parser parser(&ast_iterator, &token_stream, m_compilation_unit.Get());
     parser.Parse();
 
+    if (Config::preload_imports) {
+        ImportPreloader(m_compilation_unit.Get()).Preload(ast_iterator);
+    }
+
     semantic_analyzer.Analyze();
 
-    m_errors = m_compilation_unit.GetErrorList();
+    m_errors = m_compilation_unit->GetErrorList();
     m_errors.WriteOutput(std::cout);
 
     if (!m_errors.HasFatalErrors()) {
@@ -74,13 +152,13 @@ bool Script::Compile(scriptapi2::Context &context)
         // before this point
         ast_iterator.ResetPosition();
 
-        Optimizer optimizer(&ast_iterator, &m_compilation_unit);
+        Optimizer optimizer(&ast_iterator, m_compilation_unit.Get());
         optimizer.Optimize();
 
         // compile into bytecode instructions
         ast_iterator.ResetPosition();
 
-        Compiler compiler(&ast_iterator, &m_compilation_unit);
+        Compiler compiler(&ast_iterator, m_compilation_unit.Get());
 
         // if (auto builtins_result = builtins.Build(&m_compilation_unit)) {            
         //     m_bytecode_chunk.Append(std::move(builtins_result));
@@ -94,6 +172,10 @@ bool Script::Compile(scriptapi2::Context &context)
         // }
 
         if (auto compile_result = compiler.Compile()) {
+#if HYP_SCRIPT_ENABLE_BYTECODE_OPTIMIZATION
+            BytecodeOptimizer().Optimize(compile_result.get());
+#endif
+
             m_bytecode_chunk.Append(std::move(compile_result));
         } else {
             DebugLog(
@@ -112,9 +194,9 @@ bool Script::Compile(scriptapi2::Context &context)
 
 InstructionStream Script::Decompile(utf::utf8_ostream *os) const
 {
-    AssertThrow(IsCompiled() && IsBaked());
+    AssertThrow(IsBaked());
 
-    BytecodeStream bytecode_stream(m_baked_bytes.Data(), m_baked_bytes.Size());
+    BytecodeStream bytecode_stream(m_program);
 
     return DecompilationUnit().Decompile(bytecode_stream, os);
 }
@@ -133,28 +215,164 @@ void Script::Bake(BuildParams &build_params)
     AssertThrow(IsCompiled());
 
     CodeGenerator code_generator(build_params);
-    code_generator.Visit(&m_bytecode_chunk);
+    code_generator.Generate(&m_bytecode_chunk);
     code_generator.Bake();
 
-    m_baked_bytes = code_generator.GetInternalByteStream().GetData();
+    const Array<UByte> &bytes = code_generator.GetInternalByteStream().GetData();
+
+    Program::ExportedSymbolNames exported_symbol_names;
+    CollectExportedSymbolNames(&m_bytecode_chunk, exported_symbol_names);
+
+    const SizeType num_static_objects = SizeType(m_compilation_unit->GetInstructionStream().GetNumStaticIds());
+
+    m_program.Reset(new Program(
+        ByteBuffer(bytes.Size(), bytes.Data()),
+        num_static_objects,
+        std::move(exported_symbol_names),
+        ExceptionTable(code_generator.GetInternalByteStream().GetExceptionTableEntries()),
+        m_prelude_declarations.Resolve()
+    ));
+
+    // static memory only needs to hold the static objects this program uses
+    m_vm.GetState().m_static_memory.SetSize(num_static_objects);
 
-    m_bs = BytecodeStream(m_baked_bytes.Data(), m_baked_bytes.Size());
+    m_bs = BytecodeStream(m_program);
 }
 
 void Script::Run(scriptapi2::Context &context)
 {
-    AssertThrow(IsCompiled() && IsBaked());
+    AssertThrow(IsBaked());
 
     // bad things will happen if we don't set the VM
     m_api_instance.SetVM(&m_vm);
     
-    context.BindAll(m_api_instance, &m_vm);
+    context.BindAll(m_api_instance, &m_vm, m_program->GetBindingTable());
     m_vm.Execute(&m_bs);
 }
 
-void Script::CallFunctionArgV(const FunctionHandle &handle, Value *args, ArgCount num_args)
+Array<String> Script::GetChangedSources() const
+{
+    Array<String> changed_sources;
+
+    SourceFile source_file;
+
+    if (ReadSourceFile(m_source_file.GetFilePath(), source_file)
+        && source_file.GetBuffer().GetHashCode().Value() != m_source_hash)
+    {
+        changed_sources.PushBack(m_source_file.GetFilePath());
+    }
+
+    for (const auto &it : m_compilation_unit->m_source_hashes) {
+        if (HasSourceChanged(it.first, it.second)) {
+            changed_sources.PushBack(it.first);
+        }
+    }
+
+    return changed_sources;
+}
+
+Bool Script::Reload(scriptapi2::Context &context)
+{
+    SourceFile source_file;
+
+    if (!ReadSourceFile(m_source_file.GetFilePath(), source_file)) {
+        // not read from disk; only imports can have changed
+        source_file = m_source_file;
+    }
+
+    return Reload(context, source_file);
+}
+
+Bool Script::Reload(scriptapi2::Context &context, const SourceFile &source_file)
+{
+    if (IsBaked() && IsCompiled() && source_file.GetBuffer().GetHashCode().Value() == m_source_hash) {
+        bool imports_changed = false;
+
+        for (const auto &it : m_compilation_unit->m_source_hashes) {
+            if (HasSourceChanged(it.first, it.second)) {
+                imports_changed = true;
+
+                break;
+            }
+        }
+
+        if (!imports_changed) {
+            return true;
+        }
+    }
+
+    VMState &state = m_vm.GetState();
+    AssertThrowMsg(state.GetNumThreads() <= 1, "Cannot reload a script while calls are running on other threads");
+
+    // everything the compiler knows is built up from scratch; only parsed imports are kept, in m_parse_cache
+    m_source_file = source_file;
+    m_compilation_unit.Reset(new CompilationUnit());
+    m_bytecode_chunk.buildables.Clear();
+    m_bytecode_chunk.labels.Clear();
+
+    if (!Compile(context)) {
+        // m_program is untouched, so the VM carries on running the previous program
+        return false;
+    }
+
+    if (IsBaked()) {
+        // globals of the previous program live at the bottom of the main thread's stack,
+        // and its exports would otherwise keep the new program from exporting the same names
+        state.GetMainThread()->m_stack.Purge();
+        state.GetExportedSymbols().Clear();
+    }
+
+    Bake();
+    Run(context);
+
+    return true;
+}
+
+Continuation Script::BeginRun(scriptapi2::Context &context)
+{
+    AssertThrow(IsBaked());
+
+    // bad things will happen if we don't set the VM
+    m_api_instance.SetVM(&m_vm);
+    
+    context.BindAll(m_api_instance, &m_vm, m_program->GetBindingTable());
+
+    Continuation continuation;
+    m_vm.BeginExecute(&m_bs, m_vm.GetState().GetMainThread(), continuation);
+
+    return continuation;
+}
+
+Continuation Script::BeginCall(const FunctionHandle &handle, const Value *args, ArgCount num_args)
+{
+    AssertThrow(IsBaked());
+    AssertThrowMsg(num_args <= MathUtil::MaxSafeValue<UInt8>(), "Too many arguments (%u)", num_args);
+
+    Continuation continuation;
+
+    m_vm.BeginInvoke(
+        &m_bs,
+        handle._inner,
+        args,
+        UInt8(num_args),
+        m_vm.GetState().GetMainThread(),
+        continuation
+    );
+
+    return continuation;
+}
+
+ExecutionStatus Script::Resume(Continuation &continuation, const ExecutionBudget &budget)
 {
-    AssertThrow(IsCompiled() && IsBaked());
+    AssertThrow(IsBaked());
+
+    return m_vm.Resume(&m_bs, continuation, budget);
+}
+
+void Script::CallFunctionArgV(const FunctionHandle &handle, const Value *args, ArgCount num_args)
+{
+    AssertThrow(IsBaked());
+    AssertThrowMsg(num_args <= MathUtil::MaxSafeValue<UInt8>(), "Too many arguments (%u)", num_args);
 
     auto *main_thread = m_vm.GetState().GetMainThread();
 
@@ -169,7 +387,7 @@ void Script::CallFunctionArgV(const FunctionHandle &handle, Value *args, ArgCoun
     m_vm.InvokeNow(
         &m_bs,
         handle._inner,
-        num_args
+        UInt8(num_args)
     );
 
     if (num_args != 0) {
@@ -177,4 +395,181 @@ void Script::CallFunctionArgV(const FunctionHandle &handle, Value *args, ArgCoun
     }
 }
 
+void Script::CallFunctionBatch(const FunctionHandle &handle, Span<const Value> args, SizeType count, Value *results_out)
+{
+    AssertThrow(IsBaked());
+
+    if (count == 0) {
+        return;
+    }
+
+    AssertThrowMsg(args.size % count == 0, "Argument count %llu is not a multiple of call count %llu", args.size, count);
+
+    const SizeType num_args = args.size / count;
+    AssertThrowMsg(num_args <= MathUtil::MaxSafeValue<UInt8>(), "Too many arguments per call (%llu)", num_args);
+
+    struct ParkedCall
+    {
+        Continuation    continuation;
+        SizeType        call_index;
+    };
+
+    VMState &state = m_vm.GetState();
+
+    // a call that parks keeps its thread busy until it is resumed,
+    // so the rest of the batch moves on to another execution thread
+    ExecutionThread *thread = state.GetMainThread();
+
+    Array<ExecutionThread *> created_threads;
+    Array<ParkedCall> parked_calls;
+
+    const auto finish_parked_call = [this, results_out](ParkedCall &parked_call) -> ExecutionThread *
+    {
+        ExecutionThread *parked_thread = parked_call.continuation.thread;
+
+        while (m_vm.Resume(&m_bs, parked_call.continuation, ExecutionBudget { }) == ExecutionStatus::WAITING) {
+            // the parked thread is not executing, so collections do not wait for it
+            while (!parked_thread->m_async_result->WaitFor(std::chrono::milliseconds(10))) { }
+        }
+
+        if (results_out != nullptr) {
+            results_out[parked_call.call_index] = parked_thread->m_regs[0];
+        }
+
+        return parked_thread;
+    };
+
+    SizeType call_index = 0;
+
+    while (call_index < count) {
+        if (thread == nullptr) {
+            if (state.GetNumThreads() < VM_MAX_THREADS) {
+                thread = state.CreateThread();
+                AssertThrow(thread != nullptr);
+
+                created_threads.PushBack(thread);
+            } else {
+                // every thread is parked; wait for the oldest call to free its thread
+                thread = finish_parked_call(parked_calls.Front());
+                parked_calls.PopFront();
+            }
+        }
+
+        Continuation parked_continuation;
+
+        call_index += m_vm.InvokeBatch(
+            &m_bs,
+            handle._inner,
+            UInt8(num_args),
+            args.ptr + call_index * num_args,
+            count - call_index,
+            results_out != nullptr ? results_out + call_index : nullptr,
+            thread,
+            &parked_continuation
+        );
+
+        if (call_index < count) {
+            parked_calls.PushBack(ParkedCall { parked_continuation, call_index });
+
+            ++call_index;
+            thread = nullptr;
+        }
+    }
+
+    for (ParkedCall &parked_call : parked_calls) {
+        finish_parked_call(parked_call);
+    }
+
+    for (ExecutionThread *created_thread : created_threads) {
+        state.DestroyThread(created_thread->m_id);
+    }
+}
+
+void Script::CallFunctionsParallel(Span<ParallelCall> calls, JobDispatchProc &&dispatch)
+{
+    AssertThrow(IsBaked());
+
+    if (calls.size == 0) {
+        return;
+    }
+
+    for (SizeType call_index = 0; call_index < calls.size; call_index++) {
+        AssertThrowMsg(calls.ptr[call_index].num_args <= MathUtil::MaxSafeValue<UInt8>(), "Too many arguments (%u)", calls.ptr[call_index].num_args);
+    }
+
+    VMState &state = m_vm.GetState();
+
+    const SizeType num_workers = MathUtil::Min(calls.size, SizeType(VM_MAX_THREADS) - state.GetNumThreads());
+    AssertThrowMsg(num_workers != 0, "No free execution threads to run calls on");
+
+    std::atomic<SizeType> next_call_index { 0 };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    SizeType num_workers_running = num_workers;
+
+    ExecutionThread *worker_threads[VM_MAX_THREADS];
+
+    for (SizeType worker_index = 0; worker_index < num_workers; worker_index++) {
+        ExecutionThread *thread = state.CreateThread();
+        AssertThrow(thread != nullptr);
+
+        worker_threads[worker_index] = thread;
+    }
+
+    for (SizeType worker_index = 0; worker_index < num_workers; worker_index++) {
+        ExecutionThread *thread = worker_threads[worker_index];
+
+        dispatch(Proc<void>([this, thread, calls, &next_call_index, &mutex, &cv, &num_workers_running]()
+        {
+            // each worker reads from its own stream over the shared program
+            BytecodeStream bs(m_program);
+
+            SizeType call_index;
+
+            while ((call_index = next_call_index.fetch_add(1, std::memory_order_relaxed)) < calls.size) {
+                ParallelCall &call = calls.ptr[call_index];
+
+                for (ArgCount i = 0; i < call.num_args; i++) {
+                    thread->m_stack.Push(call.args[i]);
+                }
+
+                m_vm.InvokeNow(
+                    &bs,
+                    call.handle._inner,
+                    UInt8(call.num_args),
+                    thread
+                );
+
+                call.result = thread->m_regs[0];
+
+                if (call.num_args != 0) {
+                    thread->m_stack.Pop(call.num_args);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+
+                --num_workers_running;
+            }
+
+            cv.notify_all();
+        }));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        cv.wait(lock, [&num_workers_running]
+        {
+            return num_workers_running == 0;
+        });
+    }
+
+    for (SizeType worker_index = 0; worker_index < num_workers; worker_index++) {
+        state.DestroyThread(worker_threads[worker_index]->m_id);
+    }
+}
+
 } // namespace hyperion
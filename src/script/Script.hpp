@@ -2,15 +2,21 @@
 #define SCRIPT_HPP
 
 #include <script/ScriptApi.hpp>
+#include <script/ScriptApi2.hpp>
 #include <script/SourceFile.hpp>
 #include <script/compiler/ErrorList.hpp>
 #include <script/compiler/CompilationUnit.hpp>
+#include <script/compiler/ParseCache.hpp>
 #include <script/compiler/emit/BytecodeChunk.hpp>
 #include <script/compiler/emit/InstructionStream.hpp>
 #include <script/vm/BytecodeStream.hpp>
+#include <script/vm/Program.hpp>
 #include <script/vm/VM.hpp>
 
 #include <core/lib/FixedArray.hpp>
+#include <core/lib/Proc.hpp>
+#include <core/lib/Span.hpp>
+#include <core/lib/UniquePtr.hpp>
 #include <core/Util.hpp>
 
 #include <Constants.hpp>
@@ -27,10 +33,6 @@ namespace hyperion {
 using namespace compiler;
 using namespace vm;
 
-namespace scriptapi2 {
-class Context;
-} // namespace scriptapi2
-
 class Script
 {
 public:
@@ -54,7 +56,25 @@ public:
     struct ObjectHandle : ValueHandle { };
     struct FunctionHandle : ValueHandle { };
 
+    struct ParallelCall
+    {
+        FunctionHandle  handle;
+        const Value     *args = nullptr;
+        ArgCount        num_args = 0;
+
+        // register 0 after the call has returned. heap values are not kept
+        // alive by this, so they must be used before the script allocates again.
+        Value           result;
+    };
+
+    /*! \brief Supplied by the host to run a job on one of its worker threads. */
+    using JobDispatchProc = Proc<void, Proc<void> &&>;
+
     Script(const SourceFile &source_file);
+    /*! \brief Create a new instance of an already baked script. The instance shares
+        the immutable Program with every other instance and only owns its own VM
+        state, so it can be Run() and called into without compiling or baking. */
+    Script(const SourceFile &source_file, const RC<Program> &program);
     Script(const Script &other) = delete;
     Script &operator=(const Script &other) = delete;
     ~Script();
@@ -76,7 +96,7 @@ public:
     VM &GetVM() { return m_vm; }
     const VM &GetVM() const { return m_vm; }
 
-    Bool IsBaked() const { return m_baked_bytes.Any(); }
+    Bool IsBaked() const { return m_program != nullptr; }
     Bool IsCompiled() const { return m_bytecode_chunk.buildables.Any(); }
 
     Bool Compile(scriptapi2::Context &context);
@@ -86,8 +106,48 @@ public:
     void Bake();
     void Bake(BuildParams &build_params);
 
+    /*! \brief The baked program, shareable between any number of Script instances. */
+    const RC<Program> &GetProgram() const
+        { return m_program; }
+
+    /*! \brief Bind the Context and run the top level of the script to completion.
+        If the script calls an async native function, the calling host thread blocks
+        until its result has been completed. Use BeginRun() and Resume() to park instead. */
     void Run(scriptapi2::Context &context);
 
+    /*! \brief Returns the paths of the source files this script was compiled from (the script
+        itself, if it was read from disk, and every file it imports, directly or indirectly)
+        whose contents on disk have changed or that can no longer be read. */
+    Array<String> GetChangedSources() const;
+
+    /*! \brief Re-read the script from disk (or keep its current source, if it was not read
+        from disk) and call Reload() with it. */
+    Bool Reload(scriptapi2::Context &context);
+
+    /*! \brief Recompile the script if its source or any file it imports has changed, and patch
+        the new program into the running VM.
+        Imported files that have not changed are not lexed or parsed again. The VM keeps its heap
+        and native bindings; its exported symbols and the main thread's stack are cleared, and the
+        top level of the new program is run, which defines its globals and exports again. Handles
+        to functions or objects of the previous program must be looked up again afterwards.
+        Must not be called while a continuation or any call into the script is in progress.
+        If compilation fails, the previous program keeps running, and false is returned. */
+    Bool Reload(scriptapi2::Context &context, const SourceFile &source_file);
+
+    /*! \brief Like Run(), but only prepares the continuation. Use Resume() to run it
+        a slice at a time, e.g. spread across several frames. */
+    Continuation BeginRun(scriptapi2::Context &context);
+
+    /*! \brief Prepare a resumable call to a function on the main thread. Once Resume()
+        returns ExecutionStatus::COMPLETED, the return value is in register 0.
+        Nothing else may run on the main thread until then. */
+    Continuation BeginCall(const FunctionHandle &handle, const Value *args, ArgCount num_args);
+
+    /*! \brief Run a continuation until it completes or the budget is used up.
+        Returns WAITING while the script is parked on an async native call; call
+        Resume() again once its AsyncResult has completed. */
+    ExecutionStatus Resume(Continuation &continuation, const ExecutionBudget &budget);
+
     template <class T>
     constexpr Value CreateArgument(T &&item)
     {
@@ -151,7 +211,32 @@ public:
         };
     }
 
-    void CallFunctionArgV(const FunctionHandle &handle, Value *args, ArgCount num_args);
+    /*! \brief Call a function on the main thread and run it to completion; the return
+        value is in register 0 afterwards. If the function calls an async native function,
+        the calling host thread blocks until its result has been completed. Use BeginCall()
+        and Resume() to park instead. */
+    void CallFunctionArgV(const FunctionHandle &handle, const Value *args, ArgCount num_args);
+
+    /*! \brief Call a function \ref count times, entering the VM only once. \ref args holds
+        the arguments of every call back to back, so its size must be a multiple of
+        \ref count. The return value of each call is written to \ref results_out, if given.
+        A call that waits on an async native function is parked, and the rest of the batch
+        carries on on another execution thread, so the waits overlap. This still only returns
+        once every call has completed, blocking the calling host thread until then.
+        Must not be called while other calls into the script are running. */
+    void CallFunctionBatch(const FunctionHandle &handle, Span<const Value> args, SizeType count, Value *results_out);
+
+    /*! \brief Run all of the given calls concurrently. Up to VM_MAX_THREADS - 1 workers
+        are handed to \ref dispatch, each with its own ExecutionThread, and they pull
+        calls until none are left. All workers share this script's heap and globals;
+        garbage collection waits for each of them to reach an instruction boundary.
+        Blocks until every call has returned.
+        A worker whose call waits on an async native function blocks until it has completed.
+        Only allocation and garbage collection are synchronized: globals and heap objects
+        (arrays, objects, strings) are NOT thread-safe. Calls that run at the same time must
+        not write to a global or to a heap object that another of them reads or writes.
+        Each call may take at most 255 arguments. */
+    void CallFunctionsParallel(Span<ParallelCall> calls, JobDispatchProc &&dispatch);
 
     Bool GetFunctionHandle(const char *name, FunctionHandle &out_handle)
     {
@@ -202,6 +287,7 @@ public:
         return false;
     }
 
+    /*! \brief See CallFunctionArgV(); blocks while the function waits on an async native function. */
     template <class ...Args>
     void CallFunction(const FunctionHandle &handle, Args &&... args)
     {
@@ -247,18 +333,24 @@ public:
 
 private:
 
-    APIInstance     m_api_instance;
+    APIInstance                 m_api_instance;
 
-    SourceFile      m_source_file;
-    CompilationUnit m_compilation_unit;
-    ErrorList       m_errors;
+    SourceFile                  m_source_file;
+    // hash of the contents m_source_file had when it was compiled
+    HashCode::ValueType         m_source_hash;
+    UniquePtr<CompilationUnit>  m_compilation_unit;
+    // what m_compilation_unit declared for the Context's globals and classes
+    scriptapi2::PreludeDeclarations m_prelude_declarations;
+    // imports parsed by earlier compilations, reused by Reload()
+    ParseCache                  m_parse_cache;
+    ErrorList                   m_errors;
 
-    BytecodeChunk   m_bytecode_chunk;
+    BytecodeChunk               m_bytecode_chunk;
 
-    Bytes           m_baked_bytes;
+    RC<Program>                 m_program;
 
-    VM              m_vm;
-    BytecodeStream  m_bs;
+    VM                          m_vm;
+    BytecodeStream              m_bs;
 };
 
 } // namespace hyperion
@@ -65,6 +65,12 @@
         return; \
     } while (0)
 
+/*! \brief Start an async call from a native function, returning the vm::AsyncResult to
+    complete (from any thread) once the work is done. The native must return
+    without using any of the HYP_SCRIPT_RETURN macros. */
+#define HYP_SCRIPT_BEGIN_ASYNC() \
+    (params.handler->thread->BeginAsync())
+
 #define HYP_SCRIPT_RETURN(value) \
     do { \
         params.handler->thread->GetRegisters()[0] = value; \
@@ -57,6 +57,10 @@ ClassBuilder &ClassBuilder::StaticMethod(String name, String type_string,
 void ClassBuilder::Build() {
   Mutex::Guard guard(m_context->m_mutex);
 
+  AssertThrowMsg(!m_context->m_is_prelude_built,
+                 "Cannot add class %s after the prelude has been built",
+                 m_class_definition.name.Data());
+
   // Add `native_type_id` member to class
   m_class_definition.static_members.PushBack(
       {"native_type_id",
@@ -72,6 +76,10 @@ void ClassBuilder::Build() {
 Context &Context::Global(String name, String type_string, Value value) {
   Mutex::Guard guard(m_mutex);
 
+  AssertThrowMsg(!m_is_prelude_built,
+                 "Cannot add global %s after the prelude has been built",
+                 name.Data());
+
   m_globals.PushBack(GlobalDefinition{Symbol{name, type_string, value}});
 
   return *this;
@@ -81,6 +89,10 @@ Context &Context::Global(String name, String generic_params_string,
                          String type_string, Value value) {
   Mutex::Guard guard(m_mutex);
 
+  AssertThrowMsg(!m_is_prelude_built,
+                 "Cannot add global %s after the prelude has been built",
+                 name.Data());
+
   m_globals.PushBack(GlobalDefinition{Symbol{name, type_string, value},
                                       std::move(generic_params_string)});
 
@@ -91,6 +103,10 @@ Context &Context::Global(String name, String type_string,
                          NativeFunctionPtr_t fn) {
   Mutex::Guard guard(m_mutex);
 
+  AssertThrowMsg(!m_is_prelude_built,
+                 "Cannot add global %s after the prelude has been built",
+                 name.Data());
+
   m_globals.PushBack(GlobalDefinition{Symbol{name, type_string, fn}});
 
   return *this;
@@ -100,6 +116,10 @@ Context &Context::Global(String name, String generic_params_string,
                          String type_string, NativeFunctionPtr_t fn) {
   Mutex::Guard guard(m_mutex);
 
+  AssertThrowMsg(!m_is_prelude_built,
+                 "Cannot add global %s after the prelude has been built",
+                 name.Data());
+
   m_globals.PushBack(GlobalDefinition{Symbol{name, type_string, fn},
                                       std::move(generic_params_string)});
 
@@ -164,16 +184,145 @@ Context::ParseGenericParams(const String &generic_params_string) {
   return generic_params;
 }
 
-void Context::Visit(AstVisitor *visitor, CompilationUnit *compilation_unit) {
+void Context::BuildPrelude() {
+  Mutex::Guard prelude_guard(m_prelude_mutex);
+
+  if (m_is_prelude_built) {
+    return;
+  }
+
+  // Generate script bindings into this Context for our C++ classes.
+  // Must not hold m_mutex here, the bindings call Global() / Class().
+  g_script_bindings.GenerateAll(*this);
+
   Mutex::Guard guard(m_mutex);
 
+  // Many bindings share the same signature (e.g `function< float, float >`),
+  // so only lex and parse each distinct type string once.
+  HashMap<String, RC<AstPrototypeSpecification>> parsed_types;
+
+  const auto parse_type = [&parsed_types](Type &type) {
+    auto it = parsed_types.Find(type.type_string);
+
+    if (it == parsed_types.End()) {
+      RC<AstPrototypeSpecification> type_spec =
+          ParseTypeExpression(type.type_string)
+              .Cast<AstPrototypeSpecification>();
+      AssertThrow(type_spec != nullptr);
+
+      it = parsed_types.Insert(type.type_string, std::move(type_spec)).first;
+    }
+
+    type.type_spec = it->second;
+  };
+
   for (GlobalDefinition &global : m_globals) {
+    parse_type(global.symbol.type);
+
+    if (global.generic_params_string.HasValue()) {
+      global.generic_params =
+          ParseGenericParams(*global.generic_params_string);
+    }
+  }
+
+  for (ClassDefinition &class_definition : m_class_definitions) {
+    for (Symbol &symbol : class_definition.members) {
+      parse_type(symbol.type);
+    }
+
+    for (Symbol &symbol : class_definition.static_members) {
+      parse_type(symbol.type);
+    }
+
+    if (class_definition.generic_params_string.HasValue()) {
+      class_definition.generic_params =
+          ParseGenericParams(*class_definition.generic_params_string);
+    }
+  }
+
+  m_is_prelude_built = true;
+}
+
+BindingTable PreludeDeclarations::Resolve() const {
+  Array<GlobalBinding> global_bindings;
+  global_bindings.Reserve(globals.Size());
+
+  for (const RC<AstVariableDeclaration> &var_decl : globals) {
+    AssertThrow(var_decl != nullptr);
+    AssertThrow(var_decl->GetIdentifier() != nullptr);
+
+    const int stack_location = var_decl->GetIdentifier()->GetStackLocation();
+    AssertThrowMsg(stack_location != -1, "Global %s has no stack location",
+                   var_decl->GetName().Data());
+
+    global_bindings.PushBack(GlobalBinding{var_decl->GetName(), stack_location,
+                                           var_decl->GetNativeFunctionIndex()});
+  }
+
+  Array<ClassBinding> class_bindings;
+  class_bindings.Reserve(class_var_decls.Size());
+
+  for (SizeType i = 0; i < class_var_decls.Size(); ++i) {
+    const RC<AstVariableDeclaration> &var_decl = class_var_decls[i];
+    AssertThrow(var_decl != nullptr);
+    AssertThrow(var_decl->GetIdentifier() != nullptr);
+
+    const int stack_location = var_decl->GetIdentifier()->GetStackLocation();
+    AssertThrowMsg(stack_location != -1, "Class %s has no stack location",
+                   var_decl->GetName().Data());
+
+    AssertThrow(class_exprs[i] != nullptr);
+
+    // Ensure class SymbolType is registered
+    SymbolTypePtr_t held_type = class_exprs[i]->GetHeldType();
+    AssertThrow(held_type != nullptr);
+    held_type = held_type->GetUnaliased();
+
+    AssertThrowMsg(held_type->GetId() != -1, "Class %s has no ID",
+                   var_decl->GetName().Data());
+
+    Array<String> member_names;
+    member_names.Reserve(held_type->GetMembers().Size());
+
+    for (const SymbolTypeMember &member : held_type->GetMembers()) {
+      member_names.PushBack(member.name);
+    }
+
+    class_bindings.PushBack(ClassBinding{var_decl->GetName(), stack_location,
+                                         held_type->GetId(),
+                                         std::move(member_names)});
+  }
+
+  return BindingTable(std::move(global_bindings), std::move(class_bindings));
+}
+
+
+void Context::Visit(AstVisitor *visitor, CompilationUnit *compilation_unit,
+                    PreludeDeclarations &out_declarations) const {
+  // No lock needed: after BuildPrelude() the definitions are never written to
+  // again, and everything created here belongs to out_declarations.
+  AssertThrowMsg(m_is_prelude_built,
+                 "BuildPrelude() must be called before visiting the Context");
+
+  out_declarations.globals.Clear();
+  out_declarations.globals.Reserve(m_globals.Size());
+
+  out_declarations.class_exprs.Clear();
+  out_declarations.class_exprs.Reserve(m_class_definitions.Size());
+
+  out_declarations.class_var_decls.Clear();
+  out_declarations.class_var_decls.Reserve(m_class_definitions.Size());
+
+  Int num_native_functions = 0;
+
+  for (const GlobalDefinition &global : m_globals) {
     IdentifierFlagBits identifier_flags =
         IdentifierFlags::FLAG_CONST | IdentifierFlags::FLAG_NATIVE;
 
+    // clone the pre-parsed type, the clone is visited (and mutated) by this
+    // CompilationUnit only
     RC<AstPrototypeSpecification> type_spec =
-        ParseTypeExpression(global.symbol.type.type_string)
-            .Cast<AstPrototypeSpecification>();
+        CloneAstNode(global.symbol.type.type_spec);
     AssertThrow(type_spec != nullptr);
 
     RC<AstExpression> expr(new AstAsExpression(
@@ -184,50 +333,54 @@ void Context::Visit(AstVisitor *visitor, CompilationUnit *compilation_unit) {
             SourceLocation::eof)),
         SourceLocation::eof));
 
-    if (global.generic_params_string.HasValue()) {
-      const Array<RC<AstParameter>> generic_params =
-          ParseGenericParams(*global.generic_params_string);
-
-      if (generic_params.Any()) {
-        expr.Reset(new AstTemplateExpression(
-            expr, generic_params, type_spec,
-            AST_TEMPLATE_EXPRESSION_FLAG_NATIVE, SourceLocation::eof));
+    if (global.generic_params.Any()) {
+      expr.Reset(new AstTemplateExpression(
+          expr, CloneAllAstNodes(global.generic_params), type_spec,
+          AST_TEMPLATE_EXPRESSION_FLAG_NATIVE, SourceLocation::eof));
 
-        identifier_flags |= IdentifierFlags::FLAG_GENERIC;
+      identifier_flags |= IdentifierFlags::FLAG_GENERIC;
 
-        type_spec.Reset(); // reset type_spec so we don't double-visit it
-      }
+      type_spec.Reset(); // reset type_spec so we don't double-visit it
     }
 
-    global.var_decl.Reset(
+    RC<AstVariableDeclaration> var_decl(
         new AstVariableDeclaration(global.symbol.name, type_spec, expr,
                                    identifier_flags, SourceLocation::eof));
 
-    visitor->GetAstIterator()->Push(global.var_decl);
+    // calls to non-generic native functions are emitted as CALL_NATIVE, which
+    // indexes the table BindAll() fills in
+    if (global.symbol.value.Is<NativeFunctionPtr_t>() &&
+        !global.generic_params.Any()) {
+      var_decl->SetNativeFunctionIndex(num_native_functions++);
+    }
+
+    visitor->GetAstIterator()->Push(var_decl);
+
+    out_declarations.globals.PushBack(std::move(var_decl));
   }
 
-  for (ClassDefinition &class_definition : m_class_definitions) {
+  for (const ClassDefinition &class_definition : m_class_definitions) {
     Array<RC<AstVariableDeclaration>> members;
     members.Resize(class_definition.members.Size());
 
     Array<RC<AstVariableDeclaration>> static_members;
     static_members.Resize(class_definition.static_members.Size());
 
-    FixedArray<Pair<Array<RC<AstVariableDeclaration>> *, Array<Symbol> *>, 2>
+    FixedArray<Pair<Array<RC<AstVariableDeclaration>> *, const Array<Symbol> *>,
+               2>
         member_arrays{
-            Pair<Array<RC<AstVariableDeclaration>> *, Array<Symbol> *>{
+            Pair<Array<RC<AstVariableDeclaration>> *, const Array<Symbol> *>{
                 &members, &class_definition.members},
-            Pair<Array<RC<AstVariableDeclaration>> *, Array<Symbol> *>{
+            Pair<Array<RC<AstVariableDeclaration>> *, const Array<Symbol> *>{
                 &static_members, &class_definition.static_members}};
 
-    for (Pair<Array<RC<AstVariableDeclaration>> *, Array<Symbol> *>
+    for (Pair<Array<RC<AstVariableDeclaration>> *, const Array<Symbol> *>
              &member_array : member_arrays) {
       for (SizeType i = 0; i < member_array.second->Size(); ++i) {
         const Symbol &symbol = (*member_array.second)[i];
 
         RC<AstPrototypeSpecification> type_spec =
-            ParseTypeExpression(symbol.type.type_string)
-                .Cast<AstPrototypeSpecification>();
+            CloneAstNode(symbol.type.type_spec);
         AssertThrow(type_spec != nullptr);
 
         (*member_array.first)[i].Reset(new AstVariableDeclaration(
@@ -243,44 +396,47 @@ void Context::Visit(AstVisitor *visitor, CompilationUnit *compilation_unit) {
       }
     }
 
-    class_definition.expr.Reset(
+    RC<AstExpression> class_expr(
         new AstTypeExpression(class_definition.name, nullptr, members, {},
                               static_members, false, SourceLocation::eof));
 
     IdentifierFlagBits identifier_flags =
         IdentifierFlags::FLAG_CONST | IdentifierFlags::FLAG_NATIVE;
 
-    if (class_definition.generic_params_string.HasValue()) {
-      const Array<RC<AstParameter>> generic_params =
-          ParseGenericParams(*class_definition.generic_params_string);
+    if (class_definition.generic_params.Any()) {
+      class_expr.Reset(new AstTemplateExpression(
+          class_expr, CloneAllAstNodes(class_definition.generic_params),
+          nullptr, AST_TEMPLATE_EXPRESSION_FLAG_NATIVE, SourceLocation::eof));
 
-      if (generic_params.Any()) {
-        class_definition.expr.Reset(new AstTemplateExpression(
-            class_definition.expr, generic_params, nullptr,
-            AST_TEMPLATE_EXPRESSION_FLAG_NATIVE, SourceLocation::eof));
-
-        identifier_flags |= IdentifierFlags::FLAG_GENERIC;
-      }
+      identifier_flags |= IdentifierFlags::FLAG_GENERIC;
     }
 
-    class_definition.var_decl.Reset(new AstVariableDeclaration(
-        class_definition.name, nullptr, class_definition.expr, identifier_flags,
-        SourceLocation::eof));
+    RC<AstVariableDeclaration> var_decl(
+        new AstVariableDeclaration(class_definition.name, nullptr, class_expr,
+                                   identifier_flags, SourceLocation::eof));
+
+    visitor->GetAstIterator()->Push(var_decl);
 
-    visitor->GetAstIterator()->Push(class_definition.var_decl);
+    out_declarations.class_exprs.PushBack(std::move(class_expr));
+    out_declarations.class_var_decls.PushBack(std::move(var_decl));
   }
 }
 
-void Context::BindAll(APIInstance &api_instance, VM *vm) {
-  Mutex::Guard guard(m_mutex);
+void Context::BindAll(APIInstance &api_instance, VM *vm,
+                      const BindingTable &binding_table) const {
+  AssertThrowMsg(m_is_prelude_built,
+                 "BuildPrelude() must be called before binding the Context");
 
-  for (const GlobalDefinition &global : m_globals) {
-    AssertThrow(global.var_decl != nullptr);
-    AssertThrow(global.var_decl->GetIdentifier() != nullptr);
+  VMState &vm_state = vm->GetState();
 
-    const int stack_location =
-        global.var_decl->GetIdentifier()->GetStackLocation();
-    AssertThrowMsg(stack_location != -1, "Global %s has no stack location",
+  Array<NativeFunctionPtr_t> &native_functions = vm_state.m_native_functions;
+  native_functions.Clear();
+  native_functions.Resize(binding_table.GetNumNativeFunctions());
+
+  for (const GlobalDefinition &global : m_globals) {
+    const GlobalBinding *binding = binding_table.FindGlobal(global.symbol.name);
+    AssertThrowMsg(binding != nullptr,
+                   "Global %s was not declared when the program was compiled",
                    global.symbol.name.Data());
 
     Value value{Value::NONE, {}};
@@ -290,53 +446,43 @@ void Context::BindAll(APIInstance &api_instance, VM *vm) {
     } else if (global.symbol.value.Is<NativeFunctionPtr_t>()) {
       value = {Value::NATIVE_FUNCTION,
                {.native_func = global.symbol.value.Get<NativeFunctionPtr_t>()}};
+
+      if (binding->native_function_index != -1) {
+        native_functions[binding->native_function_index] =
+            value.m_value.native_func;
+      }
     } else {
       AssertThrow(false);
     }
 
-    VMState &vm_state = vm->GetState();
-
     AssertThrow(vm_state.GetMainThread()->GetStack().STACK_SIZE >
-                stack_location);
-    vm_state.GetMainThread()->GetStack().GetData()[stack_location] = value;
+                binding->stack_location);
+    vm_state.GetMainThread()->GetStack().GetData()[binding->stack_location] =
+        value;
   }
 
   for (const ClassDefinition &class_definition : m_class_definitions) {
-    AssertThrow(class_definition.expr != nullptr);
-
-    AssertThrow(class_definition.var_decl != nullptr);
-    AssertThrow(class_definition.var_decl->GetIdentifier() != nullptr);
-
-    const int stack_location =
-        class_definition.var_decl->GetIdentifier()->GetStackLocation();
-    AssertThrowMsg(stack_location != -1, "Class %s has no stack location",
-                   class_definition.name.Data());
-
-    // Ensure class SymbolType is registered
-    SymbolTypePtr_t held_type = class_definition.expr->GetHeldType();
-    AssertThrow(held_type != nullptr);
-    held_type = held_type->GetUnaliased();
-
-    AssertThrowMsg(held_type->GetId() != -1, "Class %s has no ID",
+    const ClassBinding *binding =
+        binding_table.FindClass(class_definition.name);
+    AssertThrowMsg(binding != nullptr,
+                   "Class %s was not declared when the program was compiled",
                    class_definition.name.Data());
 
     // Load the class object from the VM - it is stored in StaticMemory
     // at the index
 
-    VMState &vm_state = vm->GetState();
-
-    const int index = held_type->GetId();
-    AssertThrow(vm_state.m_static_memory.static_size > index);
+    const int index = binding->static_id;
+    AssertThrow(vm_state.m_static_memory.GetSize() > index);
 
     Array<Member> class_object_members;
-    class_object_members.Resize(held_type->GetMembers().Size());
+    class_object_members.Resize(binding->member_names.Size());
 
-    for (SizeType i = 0; i < held_type->GetMembers().Size(); ++i) {
-      const SymbolTypeMember &member = held_type->GetMembers()[i];
+    for (SizeType i = 0; i < binding->member_names.Size(); ++i) {
+      const String &member_name = binding->member_names[i];
 
       auto symbol_it = class_definition.static_members.FindIf(
-          [&member](const Symbol &symbol) {
-            return symbol.name == member.name;
+          [&member_name](const Symbol &symbol) {
+            return symbol.name == member_name;
           });
 
       if (symbol_it == class_definition.static_members.End()) {
@@ -426,8 +572,9 @@ void Context::BindAll(APIInstance &api_instance, VM *vm) {
 
     // Set class object in global scope
     AssertThrow(vm_state.GetMainThread()->GetStack().STACK_SIZE >
-                stack_location);
-    vm_state.GetMainThread()->GetStack().GetData()[stack_location] = value;
+                binding->stack_location);
+    vm_state.GetMainThread()->GetStack().GetData()[binding->stack_location] =
+        value;
 
     DebugLog(LogType::Info, "Set class %s at index %d\n",
              class_definition.name.Data(), index);
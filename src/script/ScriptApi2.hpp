@@ -14,9 +14,13 @@
 #include <script/compiler/ast/AstExpression.hpp>
 #include <script/compiler/ast/AstTypeExpression.hpp>
 #include <script/compiler/ast/AstParameter.hpp>
+#include <script/compiler/ast/AstPrototypeSpecification.hpp>
 
 #include <script/vm/Value.hpp>
 #include <script/vm/VM.hpp>
+#include <script/vm/BindingTable.hpp>
+
+#include <atomic>
 
 namespace hyperion {
 
@@ -29,8 +33,11 @@ using namespace compiler;
 
 struct Type
 {
-    String          type_string;
-    SymbolTypePtr_t symbol_type;
+    String                          type_string;
+    SymbolTypePtr_t                 symbol_type;
+
+    // parsed once by Context::BuildPrelude(), cloned for each CompilationUnit
+    RC<AstPrototypeSpecification>   type_spec;
 
     bool IsValid() const
         { return symbol_type != nullptr; }
@@ -104,17 +111,29 @@ struct ClassDefinition
     Optional<String>            generic_params_string;
     Array<Symbol>               members;
     Array<Symbol>               static_members;
-
-    RC<AstExpression>           expr;
-    RC<AstVariableDeclaration>  var_decl;
+    Array<RC<AstParameter>>     generic_params;
 };
 
 struct GlobalDefinition
 {
     Symbol                      symbol;
     Optional<String>            generic_params_string;
+    Array<RC<AstParameter>>     generic_params;
+};
+
+/*! \brief The declarations a single CompilationUnit made for a Context's globals and
+    classes. Filled in by Context::Visit(), so that the Context itself is never written
+    to by a compile; once semantic analysis has assigned stack locations, Resolve()
+    turns them into the BindingTable that is baked into the Program. */
+struct PreludeDeclarations
+{
+    // parallel to the Context's globals
+    Array<RC<AstVariableDeclaration>>   globals;
+    // parallel to the Context's class definitions
+    Array<RC<AstExpression>>            class_exprs;
+    Array<RC<AstVariableDeclaration>>   class_var_decls;
 
-    RC<AstVariableDeclaration>  var_decl;
+    BindingTable Resolve() const;
 };
 
 class Context;
@@ -204,15 +223,34 @@ public:
         NativeFunctionPtr_t fn
     );
 
+    /*! \brief Generate all registered script bindings into this Context and parse
+        every binding type string and generic parameter list a single time.
+        The result is an immutable prelude that any number of CompilationUnits may
+        share: Visit() only clones the pre-parsed expressions.
+        Calling this more than once is a no-op. No definitions may be added afterwards. */
+    void BuildPrelude();
+
+    bool IsPreludeBuilt() const
+        { return m_is_prelude_built; }
+
+    /*! \brief Push declarations of every global and class onto the visitor's iterator.
+        The declarations are new nodes owned by \ref out_declarations, so any number of
+        CompilationUnits may visit the same Context at once. */
     void Visit(
         AstVisitor *visitor,
-        CompilationUnit *compilation_unit
-    );
-
+        CompilationUnit *compilation_unit,
+        PreludeDeclarations &out_declarations
+    ) const;
+
+    /*! \brief Put every global and class object into the slots \ref binding_table says
+        the program reads them from. Definitions are matched by name, so the Context does
+        not have to be the one the program was compiled with, as long as it declares the
+        same globals and classes. */
     void BindAll(
         APIInstance &api_instance,
-        VM *vm
-    );
+        VM *vm,
+        const BindingTable &binding_table
+    ) const;
 
 private:
     static Array<RC<AstParameter>> ParseGenericParams(const String &generic_params_string);
@@ -221,6 +259,9 @@ private:
     Array<GlobalDefinition>     m_globals;
     Array<ClassDefinition>      m_class_definitions;
     Mutex                       m_mutex;
+
+    Mutex                       m_prelude_mutex;
+    std::atomic_bool            m_is_prelude_built { false };
 };
 
 } // namespace scriptapi2
@@ -0,0 +1,253 @@
+#include <script/ScriptScheduler.hpp>
+
+#include <core/lib/HashMap.hpp>
+#include <math/MathUtil.hpp>
+
+#include <chrono>
+
+namespace hyperion {
+
+ScriptScheduler::ScriptScheduler(UInt num_workers)
+{
+    if (num_workers == 0) {
+        num_workers = MathUtil::Max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (UInt worker_index = 0; worker_index < num_workers; worker_index++) {
+        m_queues.PushBack(UniquePtr<WorkerQueue>(new WorkerQueue()));
+    }
+
+    for (UInt worker_index = 0; worker_index < num_workers; worker_index++) {
+        m_threads.PushBack(std::thread([this, worker_index]
+        {
+            WorkerLoop(worker_index);
+        }));
+    }
+}
+
+ScriptScheduler::~ScriptScheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        m_stop = true;
+    }
+
+    m_start_cv.notify_all();
+
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ScriptScheduler::RunBatch(Span<Job> jobs)
+{
+    if (jobs.size == 0) {
+        return;
+    }
+
+    bool expected = false;
+    AssertThrowMsg(m_is_running.compare_exchange_strong(expected, true, std::memory_order_acq_rel), "RunBatch() is not reentrant; a batch is already running");
+
+    m_jobs = jobs;
+    m_groups.Clear();
+
+    // group jobs by script, keeping submission order within each group
+    HashMap<Script *, SizeType> group_indices;
+
+    for (SizeType job_index = 0; job_index < jobs.size; job_index++) {
+        Script *script = jobs.ptr[job_index].script;
+        AssertThrow(script != nullptr);
+
+        jobs.ptr[job_index].elapsed_ns = 0;
+        jobs.ptr[job_index].worker_index = -1;
+
+        auto it = group_indices.Find(script);
+
+        if (it == group_indices.End()) {
+            it = group_indices.Insert(script, m_groups.Size()).first;
+
+            m_groups.PushBack({ });
+        }
+
+        m_groups[it->second].job_indices.PushBack(job_index);
+    }
+
+    m_num_groups_remaining.store(m_groups.Size(), std::memory_order_release);
+
+    for (SizeType group_index = 0; group_index < m_groups.Size(); group_index++) {
+        WorkerQueue &queue = *m_queues[group_index % m_queues.Size()];
+
+        std::lock_guard<std::mutex> guard(queue.mutex);
+
+        queue.group_indices.PushBack(group_index);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        ++m_batch_id;
+    }
+
+    m_start_cv.notify_all();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_done_cv.wait(lock, [this]
+    {
+        return m_num_groups_remaining.load(std::memory_order_acquire) == 0;
+    });
+
+    m_is_running.store(false, std::memory_order_release);
+}
+
+void ScriptScheduler::WorkerLoop(UInt worker_index)
+{
+    UInt64 last_batch_id = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_start_cv.wait(lock, [this, last_batch_id]
+            {
+                return m_stop || m_batch_id != last_batch_id;
+            });
+
+            if (m_stop) {
+                return;
+            }
+
+            last_batch_id = m_batch_id;
+        }
+
+        while (true) {
+            // read before looking in the queues, so a group queued again after
+            // we have looked is not missed
+            const UInt64 num_requeued = m_num_requeued.load(std::memory_order_acquire);
+
+            SizeType group_index;
+
+            if (PopOrSteal(worker_index, group_index)) {
+                RunGroup(worker_index, group_index);
+
+                continue;
+            }
+
+            // nothing is queued, but parked groups may be queued again
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_work_cv.wait(lock, [this, num_requeued]
+            {
+                return m_num_groups_remaining.load(std::memory_order_acquire) == 0
+                    || m_num_requeued.load(std::memory_order_acquire) != num_requeued;
+            });
+
+            if (m_num_groups_remaining.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+        }
+    }
+}
+
+Bool ScriptScheduler::PopOrSteal(UInt worker_index, SizeType &out_group_index)
+{
+    { // take the most recently queued group from our own queue
+        WorkerQueue &queue = *m_queues[worker_index];
+
+        std::lock_guard<std::mutex> guard(queue.mutex);
+
+        if (queue.group_indices.Any()) {
+            out_group_index = queue.group_indices.PopBack();
+
+            return true;
+        }
+    }
+
+    // steal the oldest group from another worker
+    for (SizeType offset = 1; offset < m_queues.Size(); offset++) {
+        WorkerQueue &queue = *m_queues[(worker_index + offset) % m_queues.Size()];
+
+        std::lock_guard<std::mutex> guard(queue.mutex);
+
+        if (queue.group_indices.Any()) {
+            out_group_index = queue.group_indices.PopFront();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ScriptScheduler::RunGroup(UInt worker_index, SizeType group_index)
+{
+    Group &group = m_groups[group_index];
+
+    while (group.next_job < group.job_indices.Size()) {
+        Job &job = m_jobs.ptr[group.job_indices[group.next_job]];
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (!group.is_parked) {
+            group.continuation = job.script->BeginCall(job.handle, job.args, job.num_args);
+        }
+
+        const ExecutionStatus status = job.script->Resume(group.continuation, ExecutionBudget { });
+
+        const auto end = std::chrono::steady_clock::now();
+
+        job.elapsed_ns += UInt64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        job.worker_index = Int(worker_index);
+
+        if (status == ExecutionStatus::WAITING) {
+            group.is_parked = true;
+
+            // may run right away, on this thread, if the result has already been completed,
+            // so nothing of the group may be touched after this
+            const RC<AsyncResult> async_result = job.script->GetVM().GetState().GetMainThread()->m_async_result;
+            AssertThrow(async_result != nullptr);
+
+            async_result->OnComplete([this, group_index]()
+            {
+                Requeue(group_index);
+            });
+
+            return;
+        }
+
+        group.is_parked = false;
+
+        job.result = job.script->GetVM().GetState().GetMainThread()->m_regs[0];
+
+        ++group.next_job;
+    }
+
+    if (m_num_groups_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        m_done_cv.notify_all();
+        m_work_cv.notify_all();
+    }
+}
+
+void ScriptScheduler::Requeue(SizeType group_index)
+{
+    {
+        WorkerQueue &queue = *m_queues[group_index % m_queues.Size()];
+
+        std::lock_guard<std::mutex> guard(queue.mutex);
+
+        queue.group_indices.PushBack(group_index);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        m_num_requeued.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    m_work_cv.notify_one();
+}
+
+} // namespace hyperion
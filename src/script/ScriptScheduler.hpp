@@ -0,0 +1,108 @@
+#ifndef SCRIPT_SCHEDULER_HPP
+#define SCRIPT_SCHEDULER_HPP
+
+#include <script/Script.hpp>
+
+#include <core/lib/DynArray.hpp>
+#include <core/lib/UniquePtr.hpp>
+#include <core/lib/Span.hpp>
+
+#include <Types.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace hyperion {
+
+/*! \brief Runs batches of script function calls across a pool of worker threads.
+
+    Each Script instance is its own isolate: it owns its VM state and only shares
+    the immutable Program with other instances. All jobs for the same Script are
+    grouped together and run in submission order by a single worker, so a Script
+    is never touched by two threads at once. Groups are spread across per-worker
+    queues, and idle workers steal groups from the others.
+
+    A job that calls an async native function parks its group instead of blocking
+    the worker. The worker moves on to other groups, and the parked group is queued
+    again, to be resumed by any worker, once the async result has been completed. */
+class ScriptScheduler
+{
+public:
+    struct Job
+    {
+        Script                  *script = nullptr;
+        Script::FunctionHandle  handle;
+        const Value             *args = nullptr;
+        Script::ArgCount        num_args = 0;
+
+        // filled in once the batch has run.
+        // heap values in result are only valid until the script allocates again.
+        Value                   result;
+        // time spent running the call, not counting time parked on async results
+        UInt64                  elapsed_ns = 0;
+        // the worker that finished the call
+        Int                     worker_index = -1;
+    };
+
+    /*! \brief Start the worker threads. If num_workers is 0, one worker is started per hardware thread. */
+    ScriptScheduler(UInt num_workers = 0);
+    ScriptScheduler(const ScriptScheduler &other) = delete;
+    ScriptScheduler &operator=(const ScriptScheduler &other) = delete;
+    ~ScriptScheduler();
+
+    UInt NumWorkers() const
+        { return UInt(m_threads.Size()); }
+
+    /*! \brief Run every job in the batch, blocking until all of them have returned.
+        Not reentrant: only one batch may run at a time, so RunBatch() must not be called
+        from a job or from another host thread while a batch is running. */
+    void RunBatch(Span<Job> jobs);
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex          mutex;
+        Array<SizeType>     group_indices;
+    };
+
+    struct Group
+    {
+        Array<SizeType>     job_indices;
+        // index into job_indices of the job that is running, or runs next
+        SizeType            next_job = 0;
+        // the call of the job at next_job, while it is parked on an async result
+        Continuation        continuation;
+        Bool                is_parked = false;
+    };
+
+    void WorkerLoop(UInt worker_index);
+    Bool PopOrSteal(UInt worker_index, SizeType &out_group_index);
+    void RunGroup(UInt worker_index, SizeType group_index);
+    /*! \brief Queue a parked group again, once its async result has been completed. */
+    void Requeue(SizeType group_index);
+
+    Array<std::thread>              m_threads;
+    Array<UniquePtr<WorkerQueue>>   m_queues;
+
+    std::mutex                      m_mutex;
+    std::condition_variable         m_start_cv;
+    std::condition_variable         m_done_cv;
+    // wakes idle workers when a parked group is queued again, or the batch is done
+    std::condition_variable         m_work_cv;
+    UInt64                          m_batch_id = 0;
+    Bool                            m_stop = false;
+
+    // set while RunBatch() is running, the batch state below belongs to it
+    std::atomic_bool                m_is_running { false };
+    Span<Job>                       m_jobs;
+    Array<Group>                    m_groups;
+    std::atomic<SizeType>           m_num_groups_remaining { 0 };
+    // incremented (under m_mutex) each time a parked group is queued again
+    std::atomic<UInt64>             m_num_requeued { 0 };
+};
+
+} // namespace hyperion
+
+#endif
@@ -1,6 +1,7 @@
 #include <script/SourceStream.hpp>
 
 #include <stdexcept>
+#include <cstring>
 
 namespace hyperion {
 
@@ -111,6 +112,27 @@ utf::u32char SourceStream::Next(int &pos_change)
     return u32_ch;
 }
 
+SizeType SourceStream::SkipUntil(char ch)
+{
+    if (m_position >= m_file->GetSize()) {
+        return 0;
+    }
+
+    const UByte *begin = m_file->GetBuffer().Data() + m_position;
+    const SizeType remaining = m_file->GetSize() - m_position;
+
+    // memchr scans many bytes at a time, far faster than decoding one character per call to Next()
+    const void *found = std::memchr(begin, ch, remaining);
+
+    const SizeType num_bytes = found != nullptr
+        ? SizeType(static_cast<const UByte *>(found) - begin)
+        : remaining;
+
+    m_position += num_bytes;
+
+    return num_bytes;
+}
+
 void SourceStream::GoBack(int n)
 {
     if (((int)m_position - n) < 0) {
@@ -18,6 +18,23 @@ public:
     SizeType GetPosition() const { return m_position; }
     bool HasNext() const { return m_position < m_file->GetSize(); }
     utf::u32char Peek() const;
+
+    /*! \brief Returns the raw byte at \ref{offset} bytes past the current position, or 0 if past the end.
+        Unlike Peek(), no UTF-8 decoding is done, so this is only meaningful for ASCII characters. */
+    UByte PeekByte(SizeType offset = 0) const
+    {
+        const SizeType pos = m_position + offset;
+
+        return pos < m_file->GetSize() ? m_file->GetBuffer().Data()[pos] : UByte(0);
+    }
+
+    /*! \brief Advances past \ref{num_bytes} bytes that are known to be ASCII characters. */
+    void Skip(SizeType num_bytes)
+        { m_position += num_bytes; }
+
+    /*! \brief Advances to the next occurrence of the byte \ref{ch}, or to the end of the file.
+        Returns the number of bytes skipped. */
+    SizeType SkipUntil(char ch);
     utf::u32char Next();
     utf::u32char Next(int &pos_change);
     void GoBack(int n = 1);
@@ -0,0 +1,378 @@
+#include <script/compiler/ArrayBoundsAnalyzer.hpp>
+#include <script/compiler/Identifier.hpp>
+#include <script/compiler/ast/AstBlock.hpp>
+#include <script/compiler/ast/AstVariable.hpp>
+#include <script/compiler/ast/AstVariableDeclaration.hpp>
+#include <script/compiler/ast/AstBinaryExpression.hpp>
+#include <script/compiler/ast/AstUnaryExpression.hpp>
+#include <script/compiler/ast/AstArrayAccess.hpp>
+#include <script/compiler/ast/AstMember.hpp>
+#include <script/compiler/ast/AstMemberCallExpression.hpp>
+#include <script/compiler/ast/AstCallExpression.hpp>
+#include <script/compiler/ast/AstConstant.hpp>
+#include <script/compiler/ast/AstInteger.hpp>
+#include <script/compiler/ast/AstReturnStatement.hpp>
+#include <script/compiler/ast/AstIfStatement.hpp>
+#include <script/compiler/ast/AstWhileLoop.hpp>
+#include <script/compiler/ast/AstForLoop.hpp>
+#include <script/compiler/ast/AstBreakStatement.hpp>
+#include <script/compiler/ast/AstContinueStatement.hpp>
+#include <script/compiler/type-system/BuiltinTypes.hpp>
+
+#include <system/Debug.hpp>
+
+namespace hyperion::compiler {
+
+static const Identifier *GetVariableIdentifier(const AstExpression *expr)
+{
+    if (const AstVariable *expr_as_variable = dynamic_cast<const AstVariable *>(expr)) {
+        return expr_as_variable->GetProperties().GetIdentifier().Get();
+    }
+
+    return nullptr;
+}
+
+static bool IsIntConstant(const AstExpression *expr, Int32 value)
+{
+    if (expr == nullptr) {
+        return false;
+    }
+
+    const AstInteger *value_as_integer = dynamic_cast<const AstInteger *>(expr->GetDeepValueOf());
+
+    return value_as_integer != nullptr && value_as_integer->IntValue() == value;
+}
+
+// returns the target of a call to length() on an Array, which cannot change anything
+static const AstExpression *GetArrayLengthTarget(const AstExpression *expr)
+{
+    const AstCallExpression *expr_as_call = dynamic_cast<const AstCallExpression *>(expr);
+
+    if (expr_as_call == nullptr || expr_as_call->GetOverrideExpr() != nullptr || expr_as_call->GetArguments().Any()) {
+        return nullptr;
+    }
+
+    const AstMember *callee = dynamic_cast<const AstMember *>(expr_as_call->GetExpr().Get());
+
+    if (callee == nullptr || callee->GetFieldName() != "length") {
+        return nullptr;
+    }
+
+    const AstExpression *target = callee->GetTarget();
+
+    if (target == nullptr || !ArrayBoundsAnalyzer::IsArrayType(target->GetExprType())) {
+        return nullptr;
+    }
+
+    return target;
+}
+
+bool ArrayBoundsAnalyzer::IsArrayType(SymbolTypePtr_t type)
+{
+    if (type == nullptr) {
+        return false;
+    }
+
+    type = type->GetUnaliased();
+
+    if (!type->IsGenericInstanceType()) {
+        return false;
+    }
+
+    const SymbolTypePtr_t &base = type->GetBaseType();
+
+    return base != nullptr && base->GetName() == "Array";
+}
+
+SizeType ArrayBoundsAnalyzer::Analyze(
+    const AstStatement *counter_decl,
+    const AstExpression *condition,
+    const AstExpression *increment,
+    const AstBlock *block
+)
+{
+    m_counter = nullptr;
+    m_array = nullptr;
+    m_in_bounds.Clear();
+
+    const AstVariableDeclaration *decl = dynamic_cast<const AstVariableDeclaration *>(counter_decl);
+
+    if (decl == nullptr || decl->GetIdentifier() == nullptr || block == nullptr) {
+        return 0;
+    }
+
+    { // the counter is an Int that starts out non-negative
+        const Identifier *counter = decl->GetIdentifier().Get();
+
+        if ((counter->GetFlags() & (IdentifierFlags::FLAG_REF | IdentifierFlags::FLAG_CONST)) || counter->GetSymbolType() == nullptr) {
+            return 0;
+        }
+
+        if (!counter->GetSymbolType()->GetUnaliased()->TypeEqual(*BuiltinTypes::INT)) {
+            return 0;
+        }
+
+        if (decl->GetRealAssignment() == nullptr) {
+            return 0;
+        }
+
+        const AstInteger *initial_value = dynamic_cast<const AstInteger *>(decl->GetRealAssignment()->GetDeepValueOf());
+
+        if (initial_value == nullptr || initial_value->IntValue() < 0) {
+            return 0;
+        }
+
+        m_counter = counter;
+    }
+
+    { // the condition is `counter < array.length()`
+        const AstBinaryExpression *condition_as_binop = dynamic_cast<const AstBinaryExpression *>(condition);
+
+        if (condition_as_binop == nullptr || condition_as_binop->GetOperatorOverload() != nullptr) {
+            return 0;
+        }
+
+        if (condition_as_binop->GetOperator() == nullptr || condition_as_binop->GetOperator()->GetOperatorType() != OP_less) {
+            return 0;
+        }
+
+        if (GetVariableIdentifier(condition_as_binop->GetLeft().Get()) != m_counter) {
+            return 0;
+        }
+
+        const Identifier *array = GetVariableIdentifier(GetArrayLengthTarget(condition_as_binop->GetRight().Get()));
+
+        if (array == nullptr || array == m_counter || (array->GetFlags() & IdentifierFlags::FLAG_REF)) {
+            return 0;
+        }
+
+        m_array = array;
+    }
+
+    // a while loop increments the counter at the end of its body
+    const Array<RC<AstStatement>> &children = block->GetChildren();
+    SizeType num_body_statements = children.Size();
+
+    if (increment == nullptr) {
+        if (children.Empty() || !IsCounterIncrement(children.Back().Get())) {
+            return 0;
+        }
+
+        num_body_statements--;
+    } else if (!IsCounterIncrement(increment)) {
+        return 0;
+    }
+
+    for (SizeType index = 0; index < num_body_statements; index++) {
+        if (!CheckStatement(children[index].Get())) {
+            return 0;
+        }
+    }
+
+    for (AstArrayAccess *access : m_in_bounds) {
+        access->SetIsInBounds(true);
+    }
+
+    return m_in_bounds.Size();
+}
+
+bool ArrayBoundsAnalyzer::IsCounterIncrement(const AstStatement *stmt) const
+{
+    if (const AstUnaryExpression *stmt_as_unop = dynamic_cast<const AstUnaryExpression *>(stmt)) {
+        return stmt_as_unop->GetOperator() != nullptr
+            && stmt_as_unop->GetOperator()->GetOperatorType() == OP_increment
+            && GetVariableIdentifier(stmt_as_unop->GetOperand().Get()) == m_counter;
+    }
+
+    const AstBinaryExpression *stmt_as_binop = dynamic_cast<const AstBinaryExpression *>(stmt);
+
+    if (stmt_as_binop == nullptr || stmt_as_binop->GetOperatorOverload() != nullptr || stmt_as_binop->GetOperator() == nullptr) {
+        return false;
+    }
+
+    if (GetVariableIdentifier(stmt_as_binop->GetLeft().Get()) != m_counter) {
+        return false;
+    }
+
+    switch (stmt_as_binop->GetOperator()->GetOperatorType()) {
+    case OP_add_assign: // i += 1
+        return IsIntConstant(stmt_as_binop->GetRight().Get(), 1);
+    case OP_assign: { // i = i + 1
+        const AstBinaryExpression *sum = dynamic_cast<const AstBinaryExpression *>(stmt_as_binop->GetRight().Get());
+
+        return sum != nullptr
+            && sum->GetOperatorOverload() == nullptr
+            && sum->GetOperator() != nullptr
+            && sum->GetOperator()->GetOperatorType() == OP_add
+            && GetVariableIdentifier(sum->GetLeft().Get()) == m_counter
+            && IsIntConstant(sum->GetRight().Get(), 1);
+    }
+    default:
+        return false;
+    }
+}
+
+bool ArrayBoundsAnalyzer::CheckStatement(const AstStatement *stmt)
+{
+    if (stmt == nullptr) {
+        return true;
+    }
+
+    if (const AstBlock *stmt_as_block = dynamic_cast<const AstBlock *>(stmt)) {
+        for (const RC<AstStatement> &child : stmt_as_block->GetChildren()) {
+            if (!CheckStatement(child.Get())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    if (const AstVariableDeclaration *stmt_as_decl = dynamic_cast<const AstVariableDeclaration *>(stmt)) {
+        // a reference could be used to write to the array or the counter
+        if (stmt_as_decl->GetIdentifier() == nullptr || (stmt_as_decl->GetIdentifier()->GetFlags() & IdentifierFlags::FLAG_REF)) {
+            return false;
+        }
+
+        return CheckExpression(stmt_as_decl->GetRealAssignment().Get());
+    }
+
+    if (const AstReturnStatement *stmt_as_return = dynamic_cast<const AstReturnStatement *>(stmt)) {
+        return CheckExpression(stmt_as_return->GetExpression().Get());
+    }
+
+    if (const AstIfStatement *stmt_as_if = dynamic_cast<const AstIfStatement *>(stmt)) {
+        return CheckExpression(stmt_as_if->GetConditional().Get())
+            && CheckStatement(stmt_as_if->GetBlock().Get())
+            && CheckStatement(stmt_as_if->GetElseBlock().Get());
+    }
+
+    if (const AstWhileLoop *stmt_as_while = dynamic_cast<const AstWhileLoop *>(stmt)) {
+        return CheckExpression(stmt_as_while->GetConditional().Get())
+            && CheckStatement(stmt_as_while->GetBlock().Get());
+    }
+
+    if (const AstForLoop *stmt_as_for = dynamic_cast<const AstForLoop *>(stmt)) {
+        return CheckStatement(stmt_as_for->GetDeclPart().Get())
+            && CheckExpression(stmt_as_for->GetConditionPart().Get())
+            && CheckExpression(stmt_as_for->GetIncrementPart().Get())
+            && CheckStatement(stmt_as_for->GetBlock().Get());
+    }
+
+    if (dynamic_cast<const AstBreakStatement *>(stmt) || dynamic_cast<const AstContinueStatement *>(stmt)) {
+        return true;
+    }
+
+    if (const AstExpression *stmt_as_expr = dynamic_cast<const AstExpression *>(stmt)) {
+        return CheckExpression(stmt_as_expr);
+    }
+
+    return false;
+}
+
+bool ArrayBoundsAnalyzer::CheckExpression(const AstExpression *expr)
+{
+    if (expr == nullptr) {
+        return true;
+    }
+
+    if (dynamic_cast<const AstConstant *>(expr) || dynamic_cast<const AstVariable *>(expr)) {
+        return true;
+    }
+
+    if (const AstArrayAccess *expr_as_access = dynamic_cast<const AstArrayAccess *>(expr)) {
+        // accesses are marked once the whole loop is known to match
+        return CheckArrayAccess(const_cast<AstArrayAccess *>(expr_as_access));
+    }
+
+    if (dynamic_cast<const AstCallExpression *>(expr)) {
+        const AstExpression *target = GetArrayLengthTarget(expr);
+
+        return target != nullptr && CheckExpression(target);
+    }
+
+    if (dynamic_cast<const AstMemberCallExpression *>(expr)) {
+        return false;
+    }
+
+    if (const AstMember *expr_as_member = dynamic_cast<const AstMember *>(expr)) {
+        // stores to members are assignments, which only allow locals
+        return CheckExpression(expr_as_member->GetTarget());
+    }
+
+    if (const AstBinaryExpression *expr_as_binop = dynamic_cast<const AstBinaryExpression *>(expr)) {
+        // operator overloads are calls
+        if (expr_as_binop->GetOperatorOverload() != nullptr || expr_as_binop->GetOperator() == nullptr) {
+            return false;
+        }
+
+        if (expr_as_binop->GetOperator()->GetType() & ASSIGNMENT) {
+            if (!IsAssignable(expr_as_binop->GetLeft().Get())) {
+                return false;
+            }
+        } else if (!CheckExpression(expr_as_binop->GetLeft().Get())) {
+            return false;
+        }
+
+        return CheckExpression(expr_as_binop->GetRight().Get());
+    }
+
+    if (const AstUnaryExpression *expr_as_unop = dynamic_cast<const AstUnaryExpression *>(expr)) {
+        const Operator *op = expr_as_unop->GetOperator();
+
+        if (op == nullptr) {
+            return false;
+        }
+
+        if (op->ModifiesValue()) {
+            const AstExpression *operand = expr_as_unop->GetOperand().Get();
+
+            // ++ and -- on anything but a primitive may be overloaded
+            return IsAssignable(operand)
+                && operand->GetExprType() != nullptr
+                && operand->GetExprType()->GetUnaliased()->IsPrimitive();
+        }
+
+        return CheckExpression(expr_as_unop->GetOperand().Get());
+    }
+
+    return false;
+}
+
+bool ArrayBoundsAnalyzer::CheckArrayAccess(AstArrayAccess *expr)
+{
+    const AstExpression *target = expr->GetArrayTarget().Get();
+    const AstExpression *index = expr->GetIndex().Get();
+
+    if (target == nullptr || index == nullptr) {
+        return false;
+    }
+
+    // anything but an Array may have an operator[] of its own. storing to an element of an Array
+    // never changes its length
+    if (!IsArrayType(target->GetExprType())) {
+        return false;
+    }
+
+    if (!CheckExpression(target) || !CheckExpression(index) || !CheckExpression(expr->GetRhs().Get())) {
+        return false;
+    }
+
+    if (GetVariableIdentifier(target) == m_array && GetVariableIdentifier(index) == m_counter) {
+        m_in_bounds.PushBack(expr);
+    }
+
+    return true;
+}
+
+bool ArrayBoundsAnalyzer::IsAssignable(const AstExpression *target) const
+{
+    const Identifier *ident = GetVariableIdentifier(target);
+
+    return ident != nullptr
+        && ident != m_counter
+        && ident != m_array
+        && !(ident->GetFlags() & IdentifierFlags::FLAG_REF);
+}
+
+} // namespace hyperion::compiler
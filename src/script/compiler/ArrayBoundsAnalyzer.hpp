@@ -0,0 +1,73 @@
+#ifndef ARRAY_BOUNDS_ANALYZER_HPP
+#define ARRAY_BOUNDS_ANALYZER_HPP
+
+#include <script/compiler/type-system/SymbolType.hpp>
+
+#include <core/lib/DynArray.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion::compiler {
+
+// forward declarations
+class Identifier;
+class AstStatement;
+class AstExpression;
+class AstBlock;
+class AstArrayAccess;
+
+/*! \brief Finds the accesses to an array in a loop over its length that are always in range, so that
+    they can be built without the call to operator[] and its bounds check.
+
+    The loop must declare an Int counter starting at a non-negative constant, compare it with the
+    length of an Array held in a variable before each iteration, and add one to it after each iteration:
+
+        for (var i = 0; i < a.length(); i += 1) { ... a[i] ... }
+
+    A while loop directly after the declaration of the counter, with the increment as the last statement
+    of its body, is matched as well.
+
+    `a[i]` is then in range for as long as neither `a`, `i` nor the length of the array can change, so the
+    body may only contain locals, constants, operators that are not overloaded, assignments to locals
+    other than the array and the counter, accesses to Array elements, member loads, calls to
+    Array.length(), if statements, nested loops, break, continue and return. Running into anything else,
+    such as any other call, a closure or a yield, leaves the loop as it is. */
+class ArrayBoundsAnalyzer
+{
+public:
+    ArrayBoundsAnalyzer() = default;
+    ArrayBoundsAnalyzer(const ArrayBoundsAnalyzer &other) = delete;
+    ArrayBoundsAnalyzer &operator=(const ArrayBoundsAnalyzer &other) = delete;
+    ~ArrayBoundsAnalyzer() = default;
+
+    /*! \brief Marks the accesses in the loop that are always in range. \ref{increment} is null for a
+        while loop, where it is the last statement of \ref{block} instead. The loop must have been
+        analyzed, but not yet optimized. Returns the number of accesses that were marked. */
+    SizeType Analyze(
+        const AstStatement *counter_decl,
+        const AstExpression *condition,
+        const AstExpression *increment,
+        const AstBlock *block
+    );
+
+    /*! \brief Is the type a script Array, which is indexed through its native operator[]? */
+    static bool IsArrayType(SymbolTypePtr_t type);
+
+private:
+    bool IsCounterIncrement(const AstStatement *stmt) const;
+
+    bool CheckStatement(const AstStatement *stmt);
+    bool CheckExpression(const AstExpression *expr);
+    bool CheckArrayAccess(AstArrayAccess *expr);
+
+    /*! \brief Can the target of an assignment be written without changing the array or the counter? */
+    bool IsAssignable(const AstExpression *target) const;
+
+    const Identifier        *m_counter = nullptr;
+    const Identifier        *m_array = nullptr;
+    Array<AstArrayAccess *> m_in_bounds;
+};
+
+} // namespace hyperion::compiler
+
+#endif
@@ -37,6 +37,10 @@ public:
     SizeType GetSize() const
         { return m_list.Size(); }
 
+    /*! \brief All statements, regardless of the current position. */
+    const Array<RC<AstStatement>> &GetStatements() const
+        { return m_list; }
+
     RC<AstStatement> &Peek()
         { return m_list[m_position]; }
 
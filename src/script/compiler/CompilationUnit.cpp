@@ -13,10 +13,13 @@
 namespace hyperion::compiler {
 
 CompilationUnit::CompilationUnit()
-    : m_global_module(new Module(
+    : m_ast_node_arena(new AstNodeArena()),
+      m_parse_cache(nullptr),
+      m_global_module(new Module(
           hyperion::compiler::Config::global_module_name,
           SourceLocation::eof
       )),
+      m_declaration_uses(nullptr),
       m_builtins(this)
 {
     m_global_module->SetImportTreeLink(m_module_tree.TopNode());
@@ -26,7 +29,11 @@ CompilationUnit::CompilationUnit()
     m_module_tree.TopNode()->Get() = m_global_module.Get();
 }
 
-CompilationUnit::~CompilationUnit() = default;
+CompilationUnit::~CompilationUnit()
+{
+    // nodes still referenced by our members keep the arena alive until they are destroyed
+    m_ast_node_arena->Release();
+}
 
 void CompilationUnit::RegisterType(const SymbolTypePtr_t &type_ptr)
 {
@@ -97,6 +104,46 @@ void CompilationUnit::RegisterType(const SymbolTypePtr_t &type_ptr)
     m_registered_types.PushBack(type_ptr);
 }
 
+void CompilationUnit::AddIdentifierUse(Identifier *ident)
+{
+    AssertThrow(ident != nullptr);
+
+    if (m_declaration_uses != nullptr) {
+        m_declaration_uses->PushBack(ident);
+    } else {
+        ident->AddUser(nullptr);
+    }
+}
+
+void CompilationUnit::SetTypeDeclaration(const SymbolTypePtr_t &type_ptr, Identifier *ident)
+{
+    AssertThrow(type_ptr != nullptr);
+    AssertThrow(type_ptr->GetId() != -1);
+
+    const SizeType id = SizeType(type_ptr->GetId());
+
+    if (id >= m_type_declarations.Size()) {
+        m_type_declarations.Resize(id + 1);
+    }
+
+    m_type_declarations[id] = ident;
+}
+
+Identifier *CompilationUnit::GetTypeDeclaration(const SymbolTypePtr_t &type_ptr) const
+{
+    if (type_ptr == nullptr || type_ptr->GetId() == -1) {
+        return nullptr;
+    }
+
+    const SizeType id = SizeType(type_ptr->GetId());
+
+    if (id >= m_type_declarations.Size()) {
+        return nullptr;
+    }
+
+    return m_type_declarations[id];
+}
+
 Module *CompilationUnit::LookupModule(const String &name)
 {
     TreeNode<Module *> *top = m_module_tree.TopNode();
@@ -6,6 +6,7 @@
 #include <script/compiler/builtins/Builtins.hpp>
 #include <script/compiler/emit/InstructionStream.hpp>
 #include <script/compiler/ast/AstNodeBuilder.hpp>
+#include <script/compiler/ast/AstNodeArena.hpp>
 #include <script/compiler/type-system/SymbolType.hpp>
 #include <script/compiler/Tree.hpp>
 
@@ -14,10 +15,15 @@
 #include <core/lib/RefCountedPtr.hpp>
 #include <core/lib/UniquePtr.hpp>
 
+#include <HashCode.hpp>
+
 #include <memory>
 
 namespace hyperion::compiler {
 
+struct PreloadedImport;
+class ParseCache;
+
 class CompilationUnit
 {
 public:
@@ -58,14 +64,47 @@ public:
     Builtins &GetBuiltins()
         { return m_builtins; }
 
+    /** The arena AST nodes and identifiers created while compiling this unit are allocated from.
+        Make it current with an AstNodeArena::Scope. */
+    AstNodeArena *GetAstNodeArena() const
+        { return m_ast_node_arena; }
+
     const Builtins &GetBuiltins() const
         { return m_builtins; }
 
+    /** Parsed imports kept from earlier compilations, or null if imports are always parsed. */
+    ParseCache *GetParseCache() const
+        { return m_parse_cache; }
+
+    void SetParseCache(ParseCache *parse_cache)
+        { m_parse_cache = parse_cache; }
+
     /**
         Allows a non-builtin type to be used
     */
     void RegisterType(const SymbolTypePtr_t &type_ptr);
 
+    /** Records a use of the identifier. While the body of a top-level function or class
+        is being visited, the use is attributed to that declaration, so that the
+        declaration can be culled if nothing reachable uses it.
+    */
+    void AddIdentifierUse(Identifier *ident);
+
+    /** Identifiers used by the top-level declaration currently being visited,
+        or null if uses are from code that is always compiled.
+    */
+    Array<Identifier *> *GetDeclarationUses() const
+        { return m_declaration_uses; }
+
+    void SetDeclarationUses(Array<Identifier *> *declaration_uses)
+        { m_declaration_uses = declaration_uses; }
+
+    /** Maps a registered class type to the identifier it was declared as,
+        so that uses of the type (e.g a base class) count as uses of the declaration.
+    */
+    void SetTypeDeclaration(const SymbolTypePtr_t &type_ptr, Identifier *ident);
+    Identifier *GetTypeDeclaration(const SymbolTypePtr_t &type_ptr) const;
+
     /** Looks up the module with the name, taking scope into account.
         Modules with the name that are in the current module or any module
         above the current one will be considered.
@@ -76,15 +115,28 @@ public:
         and analyze more than once.
     */
     HashMap<String, Array<RC<Module>>>  m_imported_modules;
+    /** Files that were read, lexed and parsed ahead of semantic analysis
+        by an ImportPreloader, keyed by canonical path.
+    */
+    HashMap<String, RC<PreloadedImport>> m_preloaded_imports;
+    /** Maps the path of each imported file to the hash of the contents it
+        was compiled from, so a host can tell when a recompile is needed.
+    */
+    HashMap<String, HashCode::ValueType> m_source_hashes;
     Tree<Module*>                       m_module_tree;
 
 private:
+    AstNodeArena            *m_ast_node_arena;
+    ParseCache              *m_parse_cache;
+
     String                  m_exec_path;
 
     ErrorList               m_error_list;
     InstructionStream       m_instruction_stream;
     AstNodeBuilder          m_ast_node_builder;
     Array<SymbolTypePtr_t>  m_registered_types;
+    Array<Identifier *>     m_type_declarations;
+    Array<Identifier *>     *m_declaration_uses;
     Builtins                m_builtins;
 
     // the global module
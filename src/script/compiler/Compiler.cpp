@@ -72,11 +72,25 @@ std::unique_ptr<Buildable> Compiler::BuildCall(
     AstVisitor *visitor,
     Module *mod,
     const RC<AstExpression> &target,
-    UInt8 nargs
+    UInt8 nargs,
+    Bool is_tail_call
 )
 {
     std::unique_ptr<BytecodeChunk> chunk = BytecodeUtil::Make<BytecodeChunk>();
 
+    const InstructionStream &instruction_stream = visitor->GetCompilationUnit()->GetInstructionStream();
+
+    // locals of the current function, between its call info and the arguments just pushed
+    const Int frame_locals = instruction_stream.GetStackSize() - Int(nargs) - instruction_stream.GetFrameBaseStackSize();
+
+    if (is_tail_call) {
+        AssertThrow(frame_locals >= 0);
+
+        if (frame_locals > MathUtil::MaxSafeValue<UInt16>() || instruction_stream.GetFrameNumArgs() > MathUtil::MaxSafeValue<UInt8>()) {
+            is_tail_call = false;
+        }
+    }
+
     // if no target provided, do not build it in
     if (target != nullptr) {
         chunk->Append(target->Build(visitor, mod));
@@ -85,15 +99,40 @@ std::unique_ptr<Buildable> Compiler::BuildCall(
     // get active register
     UInt8 rp = visitor->GetCompilationUnit()->GetInstructionStream().GetCurrentRegister();
     
-    auto instr_call = BytecodeUtil::Make<RawOperation<>>();
-    instr_call->opcode = CALL;
-    instr_call->Accept<UInt8>(rp);
-    instr_call->Accept<UInt8>(nargs);
-    chunk->Append(std::move(instr_call));
+    if (is_tail_call) {
+        auto instr_tail_call = BytecodeUtil::Make<RawOperation<>>();
+        instr_tail_call->opcode = TAIL_CALL;
+        instr_tail_call->Accept<UInt8>(rp);
+        instr_tail_call->Accept<UInt8>(nargs);
+        instr_tail_call->Accept<UInt8>(UInt8(instruction_stream.GetFrameNumArgs()));
+        instr_tail_call->Accept<UInt16>(UInt16(frame_locals));
+        chunk->Append(std::move(instr_tail_call));
+    } else {
+        auto instr_call = BytecodeUtil::Make<RawOperation<>>();
+        instr_call->opcode = CALL;
+        instr_call->Accept<UInt8>(rp);
+        instr_call->Accept<UInt8>(nargs);
+        chunk->Append(std::move(instr_call));
+    }
 
     return chunk;
 }
 
+std::unique_ptr<Buildable> Compiler::BuildNativeCall(
+    AstVisitor *visitor,
+    Module *mod,
+    UInt16 native_function_index,
+    UInt8 nargs
+)
+{
+    auto instr_call_native = BytecodeUtil::Make<RawOperation<>>();
+    instr_call_native->opcode = CALL_NATIVE;
+    instr_call_native->Accept<UInt16>(native_function_index);
+    instr_call_native->Accept<UInt8>(nargs);
+
+    return instr_call_native;
+}
+
 std::unique_ptr<Buildable> Compiler::LoadMemberFromHash(AstVisitor *visitor, Module *mod, UInt32 hash)
 {
     UInt8 rp = visitor->GetCompilationUnit()->GetInstructionStream().GetCurrentRegister();
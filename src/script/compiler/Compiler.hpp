@@ -42,10 +42,25 @@ public:
         UInt8 nargs
     );
 
+    /** If is_tail_call is set, the call reuses the current function's frame
+        where possible, returning straight to its caller. The code following it
+        must still be valid, as it is run if the VM falls back to a normal call.
+    */
     static std::unique_ptr<Buildable> BuildCall(
         AstVisitor *visitor,
         Module *mod,
         const RC<AstExpression> &target,
+        UInt8 nargs,
+        Bool is_tail_call = false
+    );
+
+    /** Calls the function at the given index of the VM's native function table,
+        without loading it into a register first.
+    */
+    static std::unique_ptr<Buildable> BuildNativeCall(
+        AstVisitor *visitor,
+        Module *mod,
+        UInt16 native_function_index,
         UInt8 nargs
     );
 
@@ -5,5 +5,13 @@ namespace hyperion::compiler {
 const SizeType Config::max_data_members = 255;
 const char *Config::global_module_name = "global";
 bool Config::cull_unused_objects = false;
+bool Config::cull_unreachable_declarations = true;
+const SizeType Config::max_inline_function_size = 8;
+const SizeType Config::max_compile_time_evaluation_steps = 65536;
+const SizeType Config::max_compile_time_call_depth = 64;
+const SizeType Config::min_indexed_members = 8;
+bool Config::preload_imports = true;
+UInt Config::codegen_num_workers = 0;
+const SizeType Config::min_instructions_per_codegen_worker = 8192;
 
 } // namespace hyperion::compiler
@@ -14,6 +14,11 @@
 #define HYP_SCRIPT_ENABLE_VARIABLE_INLINING 1
 #define HYP_SCRIPT_AUTO_SELF_INSERTION 1
 #define HYP_SCRIPT_CALLABLE_CLASS_CONSTRUCTORS 1
+#define HYP_SCRIPT_ENABLE_FUNCTION_INLINING 1
+#define HYP_SCRIPT_ENABLE_COMPILE_TIME_EVALUATION 1
+#define HYP_SCRIPT_ENABLE_DIRECT_NATIVE_CALLS 1
+#define HYP_SCRIPT_ENABLE_ARRAY_BOUNDS_CHECK_ELIMINATION 1
+#define HYP_SCRIPT_ENABLE_BYTECODE_OPTIMIZATION 1
 
 namespace hyperion::compiler {
 
@@ -23,6 +28,22 @@ struct Config
     static const char *global_module_name;
     /** Optimize by removing unused variables */
     static bool cull_unused_objects;
+    /** Optimize by leaving out top-level functions and classes not reachable from top-level code or exports */
+    static bool cull_unreachable_declarations;
+    /** Maximum number of expression nodes in a function body for calls to it to be inlined */
+    static const SizeType max_inline_function_size;
+    /** Maximum number of statements and expressions evaluated for one call folded at compile time */
+    static const SizeType max_compile_time_evaluation_steps;
+    /** Maximum depth of nested calls while folding a call at compile time */
+    static const SizeType max_compile_time_call_depth;
+    /** Minimum number of members a type must have for member lookups to go through a hashed index */
+    static const SizeType min_indexed_members;
+    /** Read and parse imported files on worker threads before semantic analysis */
+    static bool preload_imports;
+    /** Number of threads bytecode optimization and emission are split across, or 0 for one per hardware thread */
+    static UInt codegen_num_workers;
+    /** Minimum number of instructions given to each codegen worker; smaller programs use fewer threads */
+    static const SizeType min_instructions_per_codegen_worker;
 };
 
 } // namespace hyperion::compiler
@@ -0,0 +1,541 @@
+#include <script/compiler/ConstantEvaluator.hpp>
+#include <script/compiler/Optimizer.hpp>
+#include <script/compiler/Configuration.hpp>
+#include <script/compiler/ast/AstBlock.hpp>
+#include <script/compiler/ast/AstVariable.hpp>
+#include <script/compiler/ast/AstVariableDeclaration.hpp>
+#include <script/compiler/ast/AstBinaryExpression.hpp>
+#include <script/compiler/ast/AstUnaryExpression.hpp>
+#include <script/compiler/ast/AstCallExpression.hpp>
+#include <script/compiler/ast/AstFunctionExpression.hpp>
+#include <script/compiler/ast/AstPrototypeSpecification.hpp>
+#include <script/compiler/ast/AstReturnStatement.hpp>
+#include <script/compiler/ast/AstIfStatement.hpp>
+#include <script/compiler/ast/AstWhileLoop.hpp>
+#include <script/compiler/ast/AstForLoop.hpp>
+#include <script/compiler/ast/AstBreakStatement.hpp>
+#include <script/compiler/ast/AstContinueStatement.hpp>
+#include <script/compiler/ast/AstInteger.hpp>
+#include <script/compiler/ast/AstUnsignedInteger.hpp>
+#include <script/compiler/ast/AstFloat.hpp>
+#include <script/compiler/ast/AstTrue.hpp>
+#include <script/compiler/ast/AstFalse.hpp>
+
+#include <system/Debug.hpp>
+
+namespace hyperion::compiler {
+
+static bool IsScalarValue(const AstConstant *value)
+{
+    return dynamic_cast<const AstInteger *>(value)
+        || dynamic_cast<const AstUnsignedInteger *>(value)
+        || dynamic_cast<const AstFloat *>(value)
+        || dynamic_cast<const AstTrue *>(value)
+        || dynamic_cast<const AstFalse *>(value);
+}
+
+// the VM does not convert values on assignment, so a value is only stored
+// where the declared type matches it exactly
+static bool IsValueOfType(const AstConstant *value, SymbolTypePtr_t type)
+{
+    if (value == nullptr || type == nullptr) {
+        return false;
+    }
+
+    type = type->GetUnaliased();
+
+    if (type->IsAnyType() || type->IsPlaceholderType()) {
+        return true;
+    }
+
+    SymbolTypePtr_t value_type = value->GetExprType();
+
+    return value_type != nullptr && value_type->GetUnaliased()->TypeEqual(*type);
+}
+
+static Operators GetAssignmentBaseOperator(Operators op_type)
+{
+    switch (op_type) {
+    case OP_add_assign:         return OP_add;
+    case OP_subtract_assign:    return OP_subtract;
+    case OP_multiply_assign:    return OP_multiply;
+    case OP_divide_assign:      return OP_divide;
+    case OP_modulus_assign:     return OP_modulus;
+    case OP_bitwise_xor_assign: return OP_bitwise_xor;
+    case OP_bitwise_and_assign: return OP_bitwise_and;
+    case OP_bitwise_or_assign:  return OP_bitwise_or;
+    default:                    return op_type;
+    }
+}
+
+static RC<AstConstant> MakeBool(bool value, const SourceLocation &location)
+{
+    if (value) {
+        return RC<AstTrue>(new AstTrue(location));
+    }
+
+    return RC<AstFalse>(new AstFalse(location));
+}
+
+static RC<AstConstant> ApplyOperator(Operators op_type, const RC<AstConstant> &left, const RC<AstConstant> &right)
+{
+    if (left == nullptr || right == nullptr) {
+        return nullptr;
+    }
+
+    const bool left_is_float = dynamic_cast<const AstFloat *>(left.Get()) != nullptr;
+    const bool right_is_float = dynamic_cast<const AstFloat *>(right.Get()) != nullptr;
+
+    switch (op_type) {
+    case OP_not_eql: {
+        const RC<AstConstant> equals = ApplyOperator(OP_equals, left, right);
+
+        if (equals == nullptr || equals->IsTrue() == TRI_INDETERMINATE) {
+            return nullptr;
+        }
+
+        return MakeBool(equals->IsTrue() == TRI_FALSE, left->GetLocation());
+    }
+    case OP_equals:
+    case OP_less:
+    case OP_greater:
+    case OP_less_eql:
+    case OP_greater_eql:
+        // integer constants compare a float operand as an integer, the VM does not
+        if (left_is_float != right_is_float) {
+            return nullptr;
+        }
+
+        break;
+    case OP_bitshift_left:
+    case OP_bitshift_right:
+        if (right_is_float || right->IntValue() < 0 || right->IntValue() > 31) {
+            return nullptr;
+        }
+
+        break;
+    default:
+        break;
+    }
+
+    RC<AstConstant> result = left->HandleOperator(op_type, right.Get());
+
+    if (result == nullptr || !IsScalarValue(result.Get())) {
+        return nullptr;
+    }
+
+    return result;
+}
+
+RC<AstConstant> ConstantEvaluator::Call(
+    const AstFunctionExpression *function_expr,
+    const Array<RC<AstConstant>> &args
+)
+{
+    AssertThrow(function_expr != nullptr);
+
+    if (m_depth >= Config::max_compile_time_call_depth) {
+        return nullptr;
+    }
+
+    const RC<AstBlock> &body = function_expr->GetBlockWithParameters();
+
+    if (body == nullptr || function_expr->GetParameters().Size() != args.Size()) {
+        return nullptr;
+    }
+
+    Frame frame;
+
+    for (SizeType index = 0; index < args.Size(); index++) {
+        const RC<Identifier> &ident = function_expr->GetParameters()[index]->GetIdentifier();
+        AssertThrow(ident != nullptr);
+
+        if (!IsScalarValue(args[index].Get()) || !IsValueOfType(args[index].Get(), ident->GetSymbolType())) {
+            return nullptr;
+        }
+
+        frame.Set(ident.Get(), Local { args[index], ident->GetSymbolType() });
+    }
+
+    RC<AstConstant> result;
+
+    m_depth++;
+    const Flow flow = ExecuteBlock(body.Get(), frame, result);
+    m_depth--;
+
+    // falling off the end returns nothing, which is not a constant
+    if (flow != Flow::RETURN || !IsValueOfType(result.Get(), function_expr->GetReturnType())) {
+        return nullptr;
+    }
+
+    return result;
+}
+
+ConstantEvaluator::Flow ConstantEvaluator::Execute(const AstStatement *stmt, Frame &frame, RC<AstConstant> &out_value)
+{
+    if (stmt == nullptr || !Step()) {
+        return Flow::FAIL;
+    }
+
+    if (const AstBlock *stmt_as_block = dynamic_cast<const AstBlock *>(stmt)) {
+        return ExecuteBlock(stmt_as_block, frame, out_value);
+    }
+
+    if (const AstVariableDeclaration *stmt_as_decl = dynamic_cast<const AstVariableDeclaration *>(stmt)) {
+        const RC<Identifier> &ident = stmt_as_decl->GetIdentifier();
+
+        if (ident == nullptr || stmt_as_decl->GetRealAssignment() == nullptr) {
+            return Flow::FAIL;
+        }
+
+        // uses of a const may be replaced by its assignment, which would then run
+        // again wherever it is used, in an order that is not modeled here
+        if (stmt_as_decl->IsConst() && stmt_as_decl->GetRealAssignment()->MayHaveSideEffects()) {
+            return Flow::FAIL;
+        }
+
+        RC<AstConstant> value = Evaluate(stmt_as_decl->GetRealAssignment().Get(), frame);
+
+        if (!IsValueOfType(value.Get(), stmt_as_decl->GetExprType())) {
+            return Flow::FAIL;
+        }
+
+        frame.Set(ident.Get(), Local { std::move(value), stmt_as_decl->GetExprType() });
+
+        return Flow::NEXT;
+    }
+
+    if (const AstReturnStatement *stmt_as_return = dynamic_cast<const AstReturnStatement *>(stmt)) {
+        out_value = Evaluate(stmt_as_return->GetExpression().Get(), frame);
+
+        return out_value != nullptr ? Flow::RETURN : Flow::FAIL;
+    }
+
+    if (const AstIfStatement *stmt_as_if = dynamic_cast<const AstIfStatement *>(stmt)) {
+        const RC<AstConstant> condition = Evaluate(stmt_as_if->GetConditional().Get(), frame);
+
+        if (condition == nullptr || condition->IsTrue() == TRI_INDETERMINATE) {
+            return Flow::FAIL;
+        }
+
+        if (condition->IsTrue() == TRI_TRUE) {
+            return ExecuteBlock(stmt_as_if->GetBlock().Get(), frame, out_value);
+        }
+
+        if (stmt_as_if->GetElseBlock() != nullptr) {
+            return ExecuteBlock(stmt_as_if->GetElseBlock().Get(), frame, out_value);
+        }
+
+        return Flow::NEXT;
+    }
+
+    if (const AstWhileLoop *stmt_as_while = dynamic_cast<const AstWhileLoop *>(stmt)) {
+        return ExecuteLoop(
+            stmt_as_while->GetConditional().Get(),
+            nullptr,
+            stmt_as_while->GetBlock().Get(),
+            frame,
+            out_value
+        );
+    }
+
+    if (const AstForLoop *stmt_as_for = dynamic_cast<const AstForLoop *>(stmt)) {
+        if (stmt_as_for->GetDeclPart() != nullptr) {
+            const Flow flow = Execute(stmt_as_for->GetDeclPart().Get(), frame, out_value);
+
+            if (flow != Flow::NEXT) {
+                return Flow::FAIL;
+            }
+        }
+
+        return ExecuteLoop(
+            stmt_as_for->GetConditionPart().Get(),
+            stmt_as_for->GetIncrementPart().Get(),
+            stmt_as_for->GetBlock().Get(),
+            frame,
+            out_value
+        );
+    }
+
+    if (dynamic_cast<const AstBreakStatement *>(stmt)) {
+        return Flow::BREAK;
+    }
+
+    if (dynamic_cast<const AstContinueStatement *>(stmt)) {
+        return Flow::CONTINUE;
+    }
+
+    // the return type specification is part of the body, but emits no code
+    if (dynamic_cast<const AstPrototypeSpecification *>(stmt)) {
+        return Flow::NEXT;
+    }
+
+    if (const AstExpression *stmt_as_expr = dynamic_cast<const AstExpression *>(stmt)) {
+        return Evaluate(stmt_as_expr, frame) != nullptr ? Flow::NEXT : Flow::FAIL;
+    }
+
+    return Flow::FAIL;
+}
+
+ConstantEvaluator::Flow ConstantEvaluator::ExecuteBlock(const AstBlock *block, Frame &frame, RC<AstConstant> &out_value)
+{
+    if (block == nullptr) {
+        return Flow::FAIL;
+    }
+
+    for (const RC<AstStatement> &child : block->GetChildren()) {
+        const Flow flow = Execute(child.Get(), frame, out_value);
+
+        if (flow != Flow::NEXT) {
+            return flow;
+        }
+    }
+
+    return Flow::NEXT;
+}
+
+ConstantEvaluator::Flow ConstantEvaluator::ExecuteLoop(
+    const AstExpression *condition,
+    const AstExpression *increment,
+    const AstBlock *block,
+    Frame &frame,
+    RC<AstConstant> &out_value
+)
+{
+    for (;;) {
+        const RC<AstConstant> condition_value = Evaluate(condition, frame);
+
+        if (condition_value == nullptr || condition_value->IsTrue() == TRI_INDETERMINATE) {
+            return Flow::FAIL;
+        }
+
+        if (condition_value->IsTrue() == TRI_FALSE) {
+            return Flow::NEXT;
+        }
+
+        const Flow flow = ExecuteBlock(block, frame, out_value);
+
+        if (flow == Flow::BREAK) {
+            return Flow::NEXT;
+        }
+
+        if (flow == Flow::RETURN || flow == Flow::FAIL) {
+            return flow;
+        }
+
+        if (increment != nullptr && Evaluate(increment, frame) == nullptr) {
+            return Flow::FAIL;
+        }
+    }
+}
+
+RC<AstConstant> ConstantEvaluator::Evaluate(const AstExpression *expr, Frame &frame)
+{
+    if (expr == nullptr || !Step()) {
+        return nullptr;
+    }
+
+    if (const AstConstant *expr_as_constant = dynamic_cast<const AstConstant *>(expr)) {
+        if (!IsScalarValue(expr_as_constant)) {
+            return nullptr;
+        }
+
+        return CloneAstNode(expr_as_constant);
+    }
+
+    if (const AstVariable *expr_as_variable = dynamic_cast<const AstVariable *>(expr)) {
+        const auto it = frame.Find(expr_as_variable->GetProperties().GetIdentifier().Get());
+
+        if (it != frame.End()) {
+            return it->second.value;
+        }
+
+        // not a local; only allowed if it is a const literal
+    } else if (const AstBinaryExpression *expr_as_binop = dynamic_cast<const AstBinaryExpression *>(expr)) {
+        return EvaluateBinary(expr_as_binop, frame);
+    } else if (const AstUnaryExpression *expr_as_unop = dynamic_cast<const AstUnaryExpression *>(expr)) {
+        return EvaluateUnary(expr_as_unop, frame);
+    } else if (const AstCallExpression *expr_as_call = dynamic_cast<const AstCallExpression *>(expr)) {
+        // the call may already have been folded
+        if (expr_as_call->GetValueOf() == expr_as_call) {
+            return EvaluateCall(expr_as_call, frame);
+        }
+    } else {
+        return nullptr;
+    }
+
+    const AstConstant *value_as_constant = dynamic_cast<const AstConstant *>(expr->GetValueOf());
+
+    if (value_as_constant == nullptr || !IsScalarValue(value_as_constant)) {
+        return nullptr;
+    }
+
+    return CloneAstNode(value_as_constant);
+}
+
+RC<AstConstant> ConstantEvaluator::EvaluateBinary(const AstBinaryExpression *expr, Frame &frame)
+{
+    // operator overloads are calls
+    if (expr->GetOperatorOverload() != nullptr || expr->GetLeft() == nullptr) {
+        return nullptr;
+    }
+
+    // the right side has been folded into the left
+    if (expr->GetRight() == nullptr) {
+        return Evaluate(expr->GetLeft().Get(), frame);
+    }
+
+    const Operator *op = expr->GetOperator();
+    AssertThrow(op != nullptr);
+
+    const Operators op_type = op->GetOperatorType();
+
+    if (op->GetType() & ASSIGNMENT) {
+        RC<AstConstant> value = Evaluate(expr->GetRight().Get(), frame);
+
+        if (op_type != OP_assign) {
+            value = ApplyOperator(
+                GetAssignmentBaseOperator(op_type),
+                Evaluate(expr->GetLeft().Get(), frame),
+                value
+            );
+        }
+
+        if (value == nullptr || !Assign(expr->GetLeft().Get(), value, frame)) {
+            return nullptr;
+        }
+
+        return value;
+    }
+
+    if (op_type == OP_logical_and || op_type == OP_logical_or) {
+        // the right side is only evaluated if it decides the result
+        const RC<AstConstant> left = Evaluate(expr->GetLeft().Get(), frame);
+
+        if (left == nullptr || left->IsTrue() == TRI_INDETERMINATE) {
+            return nullptr;
+        }
+
+        if ((op_type == OP_logical_and) != (left->IsTrue() == TRI_TRUE)) {
+            return MakeBool(left->IsTrue() == TRI_TRUE, expr->GetLocation());
+        }
+
+        const RC<AstConstant> right = Evaluate(expr->GetRight().Get(), frame);
+
+        if (right == nullptr || right->IsTrue() == TRI_INDETERMINATE) {
+            return nullptr;
+        }
+
+        return MakeBool(right->IsTrue() == TRI_TRUE, expr->GetLocation());
+    }
+
+    const RC<AstConstant> left = Evaluate(expr->GetLeft().Get(), frame);
+
+    if (left == nullptr) {
+        return nullptr;
+    }
+
+    return ApplyOperator(op_type, left, Evaluate(expr->GetRight().Get(), frame));
+}
+
+RC<AstConstant> ConstantEvaluator::EvaluateUnary(const AstUnaryExpression *expr, Frame &frame)
+{
+    const Operator *op = expr->GetOperator();
+    AssertThrow(op != nullptr);
+
+    const Operators op_type = op->GetOperatorType();
+
+    const RC<AstConstant> value = Evaluate(expr->GetOperand().Get(), frame);
+
+    if (value == nullptr) {
+        return nullptr;
+    }
+
+    if (op_type == OP_increment || op_type == OP_decrement) {
+        const RC<AstConstant> updated = ApplyOperator(
+            op_type == OP_increment ? OP_add : OP_subtract,
+            value,
+            RC<AstInteger>(new AstInteger(1, expr->GetLocation()))
+        );
+
+        if (updated == nullptr || !Assign(expr->GetOperand().Get(), updated, frame)) {
+            return nullptr;
+        }
+
+        return expr->IsPostfixVersion() ? value : updated;
+    }
+
+    // the operand already holds the result
+    if (expr->IsFolded()) {
+        return value;
+    }
+
+    RC<AstConstant> result = value->HandleOperator(op_type, nullptr);
+
+    if (result == nullptr || !IsScalarValue(result.Get())) {
+        return nullptr;
+    }
+
+    return result;
+}
+
+RC<AstConstant> ConstantEvaluator::EvaluateCall(const AstCallExpression *expr, Frame &frame)
+{
+    if (expr->GetOverrideExpr() != nullptr || expr->GetExpr() == nullptr) {
+        return nullptr;
+    }
+
+    const Array<RC<AstArgument>> &args = expr->GetSubstitutedArguments();
+
+    const RC<AstFunctionExpression> function_expr = Optimizer::FindConstFunction(expr->GetExpr(), args.Size());
+
+    if (function_expr == nullptr) {
+        return nullptr;
+    }
+
+    Array<RC<AstConstant>> arg_values;
+    arg_values.Reserve(args.Size());
+
+    for (const RC<AstArgument> &arg : args) {
+        if (arg == nullptr || arg->IsSplat()) {
+            return nullptr;
+        }
+
+        RC<AstConstant> value = Evaluate(arg->GetExpr().Get(), frame);
+
+        if (value == nullptr) {
+            return nullptr;
+        }
+
+        arg_values.PushBack(std::move(value));
+    }
+
+    return Call(function_expr.Get(), arg_values);
+}
+
+bool ConstantEvaluator::Assign(const AstExpression *target, const RC<AstConstant> &value, Frame &frame)
+{
+    const AstVariable *target_as_variable = dynamic_cast<const AstVariable *>(target);
+
+    if (target_as_variable == nullptr) {
+        return false;
+    }
+
+    // only the function's own locals may be written
+    const auto it = frame.Find(target_as_variable->GetProperties().GetIdentifier().Get());
+
+    if (it == frame.End() || !IsValueOfType(value.Get(), it->second.type)) {
+        return false;
+    }
+
+    it->second.value = value;
+
+    return true;
+}
+
+bool ConstantEvaluator::Step()
+{
+    return ++m_num_steps <= Config::max_compile_time_evaluation_steps;
+}
+
+} // namespace hyperion::compiler
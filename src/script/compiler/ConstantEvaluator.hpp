@@ -0,0 +1,95 @@
+#ifndef CONSTANT_EVALUATOR_HPP
+#define CONSTANT_EVALUATOR_HPP
+
+#include <script/compiler/ast/AstConstant.hpp>
+#include <script/compiler/type-system/SymbolType.hpp>
+
+#include <core/lib/FlatMap.hpp>
+#include <core/lib/DynArray.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion::compiler {
+
+// forward declarations
+class Identifier;
+class AstStatement;
+class AstExpression;
+class AstBlock;
+class AstBinaryExpression;
+class AstUnaryExpression;
+class AstCallExpression;
+class AstFunctionExpression;
+
+/*! \brief Runs calls to script functions at compile time, so that the optimizer can replace a call
+    that has constant arguments with the value it returns.
+
+    The analyzed AST of the function body is interpreted directly. Only a pure subset of the language
+    is understood: integer, float and boolean values, the function's own parameters and locals, const
+    literals declared outside of it, arithmetic, bitwise, comparison and logical operators, assignments
+    to locals, if, while and for statements, break, continue and return, and calls to other functions
+    that meet the same requirements. Running into anything else fails the evaluation, and the call is
+    left as it is. So does taking more than Config::max_compile_time_evaluation_steps steps, which keeps
+    loops that do not terminate from hanging the compiler. */
+class ConstantEvaluator
+{
+public:
+    ConstantEvaluator() = default;
+    ConstantEvaluator(const ConstantEvaluator &other) = delete;
+    ConstantEvaluator &operator=(const ConstantEvaluator &other) = delete;
+    ~ConstantEvaluator() = default;
+
+    /*! \brief Returns the value that calling \ref{function_expr} with the given arguments returns,
+        or null if the call cannot be evaluated. The function must have been analyzed. */
+    RC<AstConstant> Call(
+        const AstFunctionExpression *function_expr,
+        const Array<RC<AstConstant>> &args
+    );
+
+private:
+    enum class Flow
+    {
+        NEXT,
+        BREAK,
+        CONTINUE,
+        RETURN,
+        FAIL
+    };
+
+    struct Local
+    {
+        RC<AstConstant> value;
+        SymbolTypePtr_t type;
+    };
+
+    // locals are keyed by their identifier, which is unique to each declaration
+    using Frame = FlatMap<const Identifier *, Local>;
+
+    Flow Execute(const AstStatement *stmt, Frame &frame, RC<AstConstant> &out_value);
+    Flow ExecuteBlock(const AstBlock *block, Frame &frame, RC<AstConstant> &out_value);
+    Flow ExecuteLoop(
+        const AstExpression *condition,
+        const AstExpression *increment,
+        const AstBlock *block,
+        Frame &frame,
+        RC<AstConstant> &out_value
+    );
+
+    RC<AstConstant> Evaluate(const AstExpression *expr, Frame &frame);
+    RC<AstConstant> EvaluateBinary(const AstBinaryExpression *expr, Frame &frame);
+    RC<AstConstant> EvaluateUnary(const AstUnaryExpression *expr, Frame &frame);
+    RC<AstConstant> EvaluateCall(const AstCallExpression *expr, Frame &frame);
+
+    /*! \brief Stores the value to the local the target refers to. Fails for anything but a local. */
+    bool Assign(const AstExpression *target, const RC<AstConstant> &value, Frame &frame);
+
+    /*! \brief Counts one step of evaluation. Returns false once the limit has been reached. */
+    bool Step();
+
+    SizeType    m_num_steps = 0;
+    SizeType    m_depth = 0;
+};
+
+} // namespace hyperion::compiler
+
+#endif
@@ -2,6 +2,8 @@
 
 #include <script/compiler/type-system/BuiltinTypes.hpp>
 
+#include <core/lib/FlatSet.hpp>
+
 namespace hyperion::compiler {
 
 Identifier::Identifier(
@@ -16,7 +18,9 @@ Identifier::Identifier(
     m_flags(flags),
     m_aliasee(aliasee),
     m_symbol_type(BuiltinTypes::UNDEFINED),
-    m_is_reassigned(false)
+    m_is_reassigned(false),
+    m_native_function_index(-1),
+    m_is_used_by_root(false)
 {
 }
 
@@ -29,8 +33,55 @@ Identifier::Identifier(const Identifier &other)
       m_aliasee(other.m_aliasee),
       m_current_value(other.m_current_value),
       m_symbol_type(other.m_symbol_type),
-      m_is_reassigned(false)
+      m_is_reassigned(false),
+      m_native_function_index(other.m_native_function_index),
+      m_is_used_by_root(other.m_is_used_by_root),
+      m_users(other.m_users)
 {
 }
 
+void Identifier::AddUser(const Identifier *user)
+{
+    Identifier *unaliased = Unalias();
+
+    if (user == nullptr) {
+        unaliased->m_is_used_by_root = true;
+
+        return;
+    }
+
+    user = user->Unalias();
+
+    if (user == unaliased || unaliased->m_users.Contains(user)) {
+        return;
+    }
+
+    unaliased->m_users.PushBack(user);
+}
+
+Bool Identifier::IsReachable() const
+{
+    // walk the users back towards code that is always compiled
+    FlatSet<const Identifier *> visited;
+    Array<const Identifier *> pending { Unalias() };
+
+    while (pending.Any()) {
+        const Identifier *current = pending.PopBack();
+
+        if (current->m_is_used_by_root) {
+            return true;
+        }
+
+        if (!visited.Insert(current).second) {
+            continue;
+        }
+
+        for (const Identifier *user : current->m_users) {
+            pending.PushBack(user);
+        }
+    }
+
+    return false;
+}
+
 } // namespace hyperion::compiler
@@ -2,6 +2,7 @@
 #define IDENTIFIER_HPP
 
 #include <script/compiler/ast/AstExpression.hpp>
+#include <script/compiler/ast/AstNodeArena.hpp>
 #include <script/compiler/type-system/SymbolType.hpp>
 #include <core/lib/String.hpp>
 #include <Types.hpp>
@@ -43,6 +44,13 @@ public:
     Identifier(const String &name, int Index, IdentifierFlagBits flags, Identifier *aliasee = nullptr);
     Identifier(const Identifier &other);
 
+    /*! \brief Identifiers are allocated from the current AstNodeArena, if any. */
+    static void *operator new(std::size_t size)
+        { return AstNodeArena::New(size); }
+
+    static void operator delete(void *ptr)
+        { AstNodeArena::Delete(ptr); }
+
     const String &GetName() const { return m_name; }
     int GetIndex() const { return Unalias()->m_index; }
     
@@ -57,6 +65,11 @@ public:
         unaliased->m_stack_location = stack_location;
     }
 
+    /*! \brief Unbinds the identifier from its stack slot, so that a function body
+        can be built again in place of a call, with the parameters somewhere else. */
+    void ResetStackLocation()
+        { Unalias()->m_stack_location = -1; }
+
     void IncUseCount() const
         { Unalias()->m_usecount++; }
 
@@ -66,6 +79,14 @@ public:
     Int GetUseCount() const
         { return Unalias()->m_usecount; }
 
+    /*! \brief Records a use of this identifier from the body of the top-level declaration of \ref{user},
+        or from code that is always compiled (top-level statements, exports) if \ref{user} is null. */
+    void AddUser(const Identifier *user);
+
+    /*! \brief Returns true if this identifier is used by code that is always compiled,
+        either directly or through a chain of declarations that are themselves reachable. */
+    Bool IsReachable() const;
+
     IdentifierFlagBits GetFlags() const
         { return m_flags; }
 
@@ -81,6 +102,14 @@ public:
     void SetIsReassigned(bool is_reassigned)
         { m_is_reassigned = is_reassigned; }
 
+    /*! \brief Index into the VM's native function table of the native function bound to this
+        identifier, or -1. Calls to it are emitted as CALL_NATIVE rather than loading the value. */
+    Int GetNativeFunctionIndex() const
+        { return Unalias()->m_native_function_index; }
+
+    void SetNativeFunctionIndex(Int native_function_index)
+        { Unalias()->m_native_function_index = native_function_index; }
+
     const RC<AstExpression> &GetCurrentValue() const { return Unalias()->m_current_value; }
     void SetCurrentValue(const RC<AstExpression> &expr) { Unalias()->m_current_value = expr; }
     const SymbolTypePtr_t &GetSymbolType() const { return Unalias()->m_symbol_type; }
@@ -105,6 +134,10 @@ private:
     RC<AstExpression>   m_current_value;
     SymbolTypePtr_t     m_symbol_type;
     bool                m_is_reassigned;
+    Int                 m_native_function_index;
+    bool                m_is_used_by_root;
+
+    Array<const Identifier *>   m_users;
 
     Array<GenericInstanceTypeInfo::Arg> m_template_params;
 };
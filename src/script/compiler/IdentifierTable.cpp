@@ -19,6 +19,9 @@ IdentifierTable::IdentifierTable(const IdentifierTable &other)
     : m_identifier_index(other.m_identifier_index),
       m_identifiers(other.m_identifiers)
 {
+    if (other.m_identifiers_by_name != nullptr) {
+        m_identifiers_by_name.Reset(new HashMap<String, RC<Identifier>>(*other.m_identifiers_by_name));
+    }
 }
 
 int IdentifierTable::CountUsedVariables() const
@@ -46,6 +49,8 @@ RC<Identifier> IdentifierTable::AddAlias(const String &name, Identifier *aliasee
         aliasee->GetFlags() | FLAG_ALIAS,
         aliasee
     )));
+
+    IndexIdentifier(m_identifiers.Back());
     
     return m_identifiers.Back();
 }
@@ -77,6 +82,8 @@ RC<Identifier> IdentifierTable::AddIdentifier(
 
     m_identifiers.PushBack(ident);
 
+    IndexIdentifier(ident);
+
     return m_identifiers.Back();
 }
 
@@ -92,11 +99,54 @@ bool IdentifierTable::AddIdentifier(const RC<Identifier> &identifier)
 
     m_identifiers.PushBack(identifier);
 
+    IndexIdentifier(identifier);
+
     return true;
 }
 
+void IdentifierTable::IndexIdentifier(const RC<Identifier> &identifier)
+{
+    if (m_identifiers_by_name == nullptr) {
+        if (m_identifiers.Size() <= max_unindexed_size) {
+            return;
+        }
+
+        m_identifiers_by_name.Reset(new HashMap<String, RC<Identifier>>());
+
+        // keep the first identifier added with a name, matching lookup order
+        for (const RC<Identifier> &ident : m_identifiers) {
+            m_identifiers_by_name->Insert(ident->GetName(), ident);
+        }
+
+        return;
+    }
+
+    m_identifiers_by_name->Insert(identifier->GetName(), identifier);
+}
+
 RC<Identifier> IdentifierTable::LookUpIdentifier(const String &name)
 {
+    if (m_identifiers_by_name == nullptr) {
+        for (auto &ident : m_identifiers) {
+            if (ident != nullptr && ident->GetName() == name) {
+                return ident;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const auto it = m_identifiers_by_name->Find(name);
+
+    if (it == m_identifiers_by_name->End()) {
+        return nullptr;
+    }
+
+    if (it->second->GetName() == name) {
+        return it->second;
+    }
+
+    // names only hash the same; fall back to a full scan
     for (auto &ident : m_identifiers) {
         if (ident != nullptr) {
             if (ident->GetName() == name) {
@@ -120,6 +170,27 @@ void IdentifierTable::BindTypeToIdentifier(const String &name, SymbolTypePtr_t s
 
 SymbolTypePtr_t IdentifierTable::LookupSymbolType(const String &name) const
 {
+    if (m_symbol_types_by_name == nullptr) {
+        for (auto &type : m_symbol_types) {
+            if (type != nullptr && type->GetName() == name) {
+                return type;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const auto it = m_symbol_types_by_name->Find(name);
+
+    if (it == m_symbol_types_by_name->End()) {
+        return nullptr;
+    }
+
+    if (it->second->GetName() == name) {
+        return it->second;
+    }
+
+    // names only hash the same; fall back to a full scan
     for (auto &type : m_symbol_types) {
         if (type != nullptr && type->GetName() == name) {
             return type;
@@ -131,7 +202,31 @@ SymbolTypePtr_t IdentifierTable::LookupSymbolType(const String &name) const
 
 void IdentifierTable::AddSymbolType(const SymbolTypePtr_t &type)
 {
+    AssertThrow(type != nullptr);
+
     m_symbol_types.PushBack(type);
+
+    IndexSymbolType(type);
+}
+
+void IdentifierTable::IndexSymbolType(const SymbolTypePtr_t &type)
+{
+    if (m_symbol_types_by_name == nullptr) {
+        if (m_symbol_types.Size() <= max_unindexed_size) {
+            return;
+        }
+
+        m_symbol_types_by_name.Reset(new HashMap<String, SymbolTypePtr_t>());
+
+        // keep the first type added with a name, matching lookup order
+        for (const SymbolTypePtr_t &symbol_type : m_symbol_types) {
+            m_symbol_types_by_name->Insert(symbol_type->GetName(), symbol_type);
+        }
+
+        return;
+    }
+
+    m_symbol_types_by_name->Insert(type->GetName(), type);
 }
 
 } // namespace hyperion::compiler
@@ -6,6 +6,8 @@
 #include <script/compiler/type-system/BuiltinTypes.hpp>
 
 #include <core/lib/String.hpp>
+#include <core/lib/HashMap.hpp>
+#include <core/lib/UniquePtr.hpp>
 
 #include <string>
 #include <memory>
@@ -16,6 +18,10 @@ namespace hyperion::compiler {
 class IdentifierTable
 {
 public:
+    /** Tables with at most this many entries are scanned rather than indexed by name.
+        Most scopes only declare a few names, and an empty HashMap already allocates its buckets. */
+    static constexpr SizeType max_unindexed_size = 8;
+
     IdentifierTable();
     IdentifierTable(const IdentifierTable &other);
 
@@ -37,7 +43,8 @@ public:
 
     bool AddIdentifier(const RC<Identifier> &identifier);
 
-    /** Look up an identifier by name. Returns nullptr if not found */
+    /** Look up an identifier by name. Returns nullptr if not found.
+        If multiple identifiers share the name, the first one added is returned. */
     RC<Identifier> LookUpIdentifier(const String &name);
 
     void BindTypeToIdentifier(const String &name, SymbolTypePtr_t symbol_type);
@@ -48,13 +55,20 @@ public:
     void AddSymbolType(const SymbolTypePtr_t &type);
 
 private:
+    void IndexIdentifier(const RC<Identifier> &identifier);
+    void IndexSymbolType(const SymbolTypePtr_t &type);
+
     /** To be incremented every time a new identifier is added */
     Int                     m_identifier_index;
     /** List of all identifiers in the table */
     Array<RC<Identifier>>   m_identifiers;
+    /** Identifiers by name, so lookups do not scan the whole list. Built once the list outgrows max_unindexed_size */
+    UniquePtr<HashMap<String, RC<Identifier>>>  m_identifiers_by_name;
 
     /** All types that are defined in this identifier table */
     Array<SymbolTypePtr_t>  m_symbol_types;
+    /** Types by name, so lookups do not scan the whole list. Built once the list outgrows max_unindexed_size */
+    UniquePtr<HashMap<String, SymbolTypePtr_t>> m_symbol_types_by_name;
 };
 
 } // namespace hyperion::compiler
@@ -0,0 +1,202 @@
+#include <script/compiler/ImportPreloader.hpp>
+#include <script/compiler/CompilationUnit.hpp>
+#include <script/compiler/ParseCache.hpp>
+#include <script/compiler/Lexer.hpp>
+#include <script/compiler/Parser.hpp>
+#include <script/compiler/ast/AstImport.hpp>
+#include <script/compiler/ast/AstFileImport.hpp>
+#include <script/compiler/ast/AstModuleImport.hpp>
+#include <script/compiler/ast/AstModuleDeclaration.hpp>
+#include <script/compiler/ast/AstNodeArena.hpp>
+#include <script/SourceFile.hpp>
+#include <script/SourceStream.hpp>
+
+#include <math/MathUtil.hpp>
+
+#include <atomic>
+#include <thread>
+#include <fstream>
+
+namespace hyperion::compiler {
+
+ImportPreloader::ImportPreloader(CompilationUnit *compilation_unit, UInt num_workers)
+    : m_compilation_unit(compilation_unit),
+      m_num_workers(num_workers),
+      m_num_preloaded(0)
+{
+    AssertThrow(m_compilation_unit != nullptr);
+
+    if (m_num_workers == 0) {
+        m_num_workers = MathUtil::Max(std::thread::hardware_concurrency(), 1u);
+    }
+}
+
+void ImportPreloader::Preload(const AstIterator &ast_iterator)
+{
+    Array<String> filepaths;
+    CollectImports(ast_iterator.GetStatements(), filepaths);
+
+    // each pass parses the files discovered by the previous one
+    while (filepaths.Any()) {
+        Array<RC<PreloadedImport>> results;
+        ParseFiles(filepaths, results);
+
+        filepaths.Clear();
+
+        // results are in the same order as the paths, so what is stored does not depend on timing
+        for (RC<PreloadedImport> &result : results) {
+            if (result == nullptr) {
+                continue;
+            }
+
+            CollectImports(result->ast_iterator.GetStatements(), filepaths);
+
+            m_compilation_unit->m_preloaded_imports.Set(
+                AstImport::GetCanonicalPath(result->filepath),
+                std::move(result)
+            );
+
+            m_num_preloaded++;
+        }
+    }
+}
+
+void ImportPreloader::CollectImports(const Array<RC<AstStatement>> &statements, Array<String> &out_filepaths)
+{
+    const FlatSet<String> &global_scan_paths = m_compilation_unit->GetGlobalModule()->GetScanPaths();
+
+    for (const RC<AstStatement> &stmt : statements) {
+        String filepath;
+
+        if (AstModuleDeclaration *module_declaration = dynamic_cast<AstModuleDeclaration *>(stmt.Get())) {
+            // imports are only allowed at global scope, which includes nested modules
+            CollectImports(module_declaration->GetChildren(), out_filepaths);
+
+            continue;
+        } else if (AstFileImport *file_import = dynamic_cast<AstFileImport *>(stmt.Get())) {
+            filepath = file_import->GetFilePath();
+        } else if (AstModuleImport *module_import = dynamic_cast<AstModuleImport *>(stmt.Get())) {
+            if (module_import->GetParts().Empty() || module_import->GetParts().Front() == nullptr) {
+                continue;
+            }
+
+            // scan paths added to the importing module during analysis are not known yet
+            FlatSet<String> scan_paths;
+            scan_paths.Insert(module_import->GetCurrentDirectory());
+
+            for (const String &scan_path : global_scan_paths) {
+                scan_paths.Insert(scan_path);
+            }
+
+            Array<String> tried_paths;
+
+            filepath = AstModuleImport::FindModuleFile(
+                module_import->GetParts().Front()->GetLeft(),
+                scan_paths,
+                tried_paths
+            );
+        }
+
+        if (filepath.Empty()) {
+            continue;
+        }
+
+        if (m_seen_paths.Insert(AstImport::GetCanonicalPath(filepath)).second) {
+            out_filepaths.PushBack(filepath);
+        }
+    }
+}
+
+void ImportPreloader::ParseFiles(const Array<String> &filepaths, Array<RC<PreloadedImport>> &out_results) const
+{
+    out_results.Resize(filepaths.Size());
+
+    const UInt num_threads = MathUtil::Min(m_num_workers, UInt(filepaths.Size()));
+
+    if (num_threads <= 1) {
+        for (SizeType index = 0; index < filepaths.Size(); index++) {
+            out_results[index] = ParseFile(filepaths[index]);
+        }
+
+        return;
+    }
+
+    std::atomic<SizeType> next_index { 0 };
+
+    Array<std::thread> threads;
+    threads.Reserve(num_threads);
+
+    for (UInt thread_index = 0; thread_index < num_threads; thread_index++) {
+        threads.PushBack(std::thread([this, &filepaths, &out_results, &next_index]
+        {
+            SizeType index;
+
+            while ((index = next_index.fetch_add(1, std::memory_order_relaxed)) < filepaths.Size()) {
+                out_results[index] = ParseFile(filepaths[index]);
+            }
+        }));
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+RC<PreloadedImport> ImportPreloader::ParseFile(const String &filepath) const
+{
+    std::ifstream file;
+
+    if (!AstImport::TryOpenFile(filepath, file)) {
+        // reported when the import is analyzed
+        return nullptr;
+    }
+
+    // get number of bytes
+    SizeType max = file.tellg();
+    // seek to beginning
+    file.seekg(0, std::ios::beg);
+    // load stream into file buffer
+    SourceFile source_file(filepath, max);
+
+    ByteBuffer temp;
+    temp.SetSize(max);
+
+    file.read(reinterpret_cast<char *>(temp.Data()), max);
+
+    source_file.ReadIntoBuffer(temp);
+
+    RC<PreloadedImport> result = RC<PreloadedImport>::Construct();
+    result->filepath = filepath;
+    result->content_hash = temp.GetHashCode().Value();
+
+    ParseCache *parse_cache = m_compilation_unit->GetParseCache();
+
+    if (parse_cache != nullptr && parse_cache->Get(filepath, result->content_hash, result->ast_iterator, result->errors)) {
+        return result;
+    }
+
+    // the lexer and parser only use the compilation unit for reporting errors;
+    // a unit per file keeps workers from sharing an ErrorList, and gives the file's nodes their own arena
+    CompilationUnit unit;
+    AstNodeArena::Scope ast_node_arena_scope(unit.GetAstNodeArena());
+
+    TokenStream token_stream(TokenStreamInfo {
+        filepath
+    });
+
+    Lexer lexer(SourceStream(&source_file), &token_stream, &unit);
+    lexer.Analyze();
+
+    Parser parser(&result->ast_iterator, &token_stream, &unit);
+    parser.Parse();
+
+    result->errors = unit.GetErrorList();
+
+    if (parse_cache != nullptr) {
+        parse_cache->Set(filepath, result->content_hash, result->ast_iterator, result->errors);
+    }
+
+    return result;
+}
+
+} // namespace hyperion::compiler
@@ -0,0 +1,75 @@
+#ifndef IMPORT_PRELOADER_HPP
+#define IMPORT_PRELOADER_HPP
+
+#include <script/compiler/AstIterator.hpp>
+#include <script/compiler/ErrorList.hpp>
+
+#include <core/lib/String.hpp>
+#include <core/lib/DynArray.hpp>
+#include <core/lib/FlatSet.hpp>
+
+#include <HashCode.hpp>
+#include <Types.hpp>
+
+namespace hyperion::compiler {
+
+class CompilationUnit;
+
+/*! \brief A file that was read, lexed and parsed ahead of semantic analysis. */
+struct PreloadedImport
+{
+    // the path the file was read as, which the parsed nodes' source locations refer to
+    String              filepath;
+    // hash of the file's contents
+    HashCode::ValueType content_hash;
+    AstIterator         ast_iterator;
+    // errors from lexing and parsing, merged into the compilation unit when the file is imported
+    ErrorList           errors;
+};
+
+/*! \brief Discovers the files a script imports, and reads, lexes and parses them on worker threads
+    before semantic analysis begins.
+
+    The top-level statements of the parsed script are scanned for file and module imports, whose
+    paths are resolved the same way AstFileImport and AstModuleImport resolve them. All files found
+    are parsed in parallel, then the new files are scanned for their own imports, and so on until the
+    whole import graph has been loaded. Each result is stored in the compilation unit by canonical
+    path, in a fixed order, and AstImport uses it in place of parsing the file itself.
+
+    If the compilation unit has a ParseCache, files whose contents have not changed since they were
+    cached are cloned from it instead of being parsed again, and newly parsed files are added to it.
+
+    Imports are still analyzed one after another, in source order, so the result of the compilation
+    does not depend on which worker finishes first. An import that the pre-scan could not resolve
+    (e.g. one relying on scan paths added during analysis) is simply parsed on demand, as before. */
+class ImportPreloader
+{
+public:
+    /*! \brief If num_workers is 0, up to one worker per hardware thread is used. */
+    ImportPreloader(CompilationUnit *compilation_unit, UInt num_workers = 0);
+    ImportPreloader(const ImportPreloader &other) = delete;
+    ImportPreloader &operator=(const ImportPreloader &other) = delete;
+    ~ImportPreloader() = default;
+
+    /*! \brief Returns the number of files that were preloaded. */
+    SizeType GetNumPreloaded() const
+        { return m_num_preloaded; }
+
+    /*! \brief Preloads every file imported, directly or indirectly, by the given statements. */
+    void Preload(const AstIterator &ast_iterator);
+
+private:
+    void CollectImports(const Array<RC<AstStatement>> &statements, Array<String> &out_filepaths);
+    void ParseFiles(const Array<String> &filepaths, Array<RC<PreloadedImport>> &out_results) const;
+
+    RC<PreloadedImport> ParseFile(const String &filepath) const;
+
+    CompilationUnit     *m_compilation_unit;
+    UInt                m_num_workers;
+    FlatSet<String>     m_seen_paths;
+    SizeType            m_num_preloaded;
+};
+
+} // namespace hyperion::compiler
+
+#endif
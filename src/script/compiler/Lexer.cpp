@@ -14,6 +14,37 @@ namespace hyperion::compiler {
 
 using namespace utf;
 
+enum LexerCharClass : UInt8
+{
+    LEXER_CHAR_CLASS_NONE   = 0x0,
+    LEXER_CHAR_CLASS_SPACE  = 0x1,
+    LEXER_CHAR_CLASS_IDENT  = 0x2  // letters, digits, '_' and '$'
+};
+
+// classification of ASCII characters, so the common cases are a single table lookup
+// rather than a UTF-8 decode followed by a chain of comparisons
+static const struct LexerCharClassTable
+{
+    UInt8 classes[128];
+
+    LexerCharClassTable()
+        : classes { }
+    {
+        for (UInt ch = 0; ch < 128; ch++) {
+            if (utf32_isspace(u32char(ch))) {
+                classes[ch] |= LEXER_CHAR_CLASS_SPACE;
+            }
+
+            if (utf32_isalpha(u32char(ch)) || utf32_isdigit(u32char(ch)) || ch == '_' || ch == '$') {
+                classes[ch] |= LEXER_CHAR_CLASS_IDENT;
+            }
+        }
+    }
+
+    bool Is(UByte ch, LexerCharClass char_class) const
+        { return ch < 128 && (classes[ch] & char_class); }
+} g_char_classes;
+
 Lexer::Lexer(
     const SourceStream &source_stream,
     TokenStream *token_stream,
@@ -73,16 +104,13 @@ Token Lexer::NextToken()
 {
     SourceLocation location = m_source_location;
 
-    std::array<u32char, 3> ch;
-    int total_pos_change = 0;
-    for (int i = 0; i < 3; i++) {
-        int pos_change = 0;
-        ch[i] = m_source_stream.Next(pos_change);
-        total_pos_change += pos_change;
-    }
-
-    // go back to previous position
-    m_source_stream.GoBack(total_pos_change);
+    // only the first character may be a multi-byte character we need to decode;
+    // the following ones are only ever compared against ASCII characters.
+    const std::array<u32char, 3> ch {
+        m_source_stream.Peek(),
+        u32char(m_source_stream.PeekByte(1)),
+        u32char(m_source_stream.PeekByte(2))
+    };
 
     if (ch[0] == '\"' || ch[0] == '\'') {
         return ReadStringLiteral();
@@ -306,6 +334,8 @@ Token Lexer::ReadStringLiteral()
             u32char esc = ReadEscapeCode();
             // append the bytes
             value.Append(utf::get_bytes(esc));
+        } else if (ch < 0x80) {
+            value.Append(char(ch));
         } else {
             // Append the character itself
             value.Append(utf::get_bytes(ch));
@@ -347,7 +377,7 @@ Token Lexer::ReadNumberLiteral()
     while (m_source_stream.HasNext() && utf32_isdigit(ch)) {
         int pos_change = 0;
         u32char next_ch = m_source_stream.Next(pos_change);
-        value.Append(utf::get_bytes(next_ch));
+        value.Append(char(next_ch));
         m_source_location.GetColumn() += pos_change;
 
         if (token_class != TK_FLOAT) {
@@ -363,7 +393,7 @@ Token Lexer::ReadNumberLiteral()
                     if (!utf::utf32_isalpha(next) && next != (u32char)'_') {
                         // type is a float because of '.' and not an identifier after
                         token_class = TK_FLOAT;
-                        value.Append(utf::get_bytes(ch));
+                        value.Append(char(ch));
                         m_source_location.GetColumn() += pos_change;
                     } else {
                         // not a float literal, so go back on the '.'
@@ -380,7 +410,7 @@ Token Lexer::ReadNumberLiteral()
                 has_exponent = true;
 
                 token_class = TK_FLOAT;
-                value.Append(utf::get_bytes(ch));
+                value.Append(char(ch));
 
                 int pos_change = 0;
                 m_source_stream.Next(pos_change);
@@ -390,7 +420,7 @@ Token Lexer::ReadNumberLiteral()
 
                 // Handle negative exponent
                 if (ch == (u32char)'-') {
-                    value.Append(utf::get_bytes(ch));
+                    value.Append(char(ch));
 
                     int pos_change = 0;
                     m_source_stream.Next(pos_change);
@@ -486,11 +516,7 @@ Token Lexer::ReadLineComment()
     }
 
     // read until newline or EOF is reached
-    while (m_source_stream.HasNext() && m_source_stream.Peek() != '\n') {
-        int pos_change = 0;
-        m_source_stream.Next(pos_change);
-        m_source_location.GetColumn() += pos_change;
-    }
+    m_source_location.GetColumn() += int(m_source_stream.SkipUntil('\n'));
 
     return Token(TK_NEWLINE, "newline", location);
 }
@@ -635,17 +661,33 @@ Token Lexer::ReadIdentifier()
     // store the name in this string
     String value;
 
-    // the character as a utf-32 character
-    auto ch = m_source_stream.Peek();
+    while (true) {
+        const UByte byte = m_source_stream.PeekByte();
+
+        if (byte < 0x80) {
+            if (!g_char_classes.Is(byte, LEXER_CHAR_CLASS_IDENT)) {
+                break;
+            }
+
+            m_source_stream.Skip(1);
+            m_source_location.GetColumn()++;
+            value.Append(char(byte));
+
+            continue;
+        }
+
+        // the character as a utf-32 character
+        u32char ch = m_source_stream.Peek();
+
+        if (!utf32_isalpha(ch)) {
+            break;
+        }
 
-    while (utf32_isdigit(ch) || utf32_isalpha(ch) || ch == '_' || ch == '$') {
         int pos_change = 0;
-        ch = m_source_stream.Next(pos_change);
+        m_source_stream.Next(pos_change);
         m_source_location.GetColumn() += pos_change;
         // append the raw bytes
         value.Append(utf::get_bytes(ch));
-        // set ch to be the next character in the buffer
-        ch = m_source_stream.Peek();
 
         // if (ch == ':') {
         //     int pos_change = 0;
@@ -738,14 +780,22 @@ bool Lexer::SkipWhitespace()
 {
     bool had_newline = false;
 
-    while (m_source_stream.HasNext() && utf32_isspace(m_source_stream.Peek())) {
-        int pos_change = 0;
-        if (m_source_stream.Next(pos_change) == (u32char)'\n') {
+    // whitespace characters are all ASCII, so no decoding is needed
+    while (m_source_stream.HasNext()) {
+        const UByte byte = m_source_stream.PeekByte();
+
+        if (!g_char_classes.Is(byte, LEXER_CHAR_CLASS_SPACE)) {
+            break;
+        }
+
+        m_source_stream.Skip(1);
+
+        if (byte == UByte('\n')) {
             m_source_location.GetLine()++;
             m_source_location.GetColumn() = 0;
             had_newline = true;
         } else {
-            m_source_location.GetColumn() += pos_change;
+            m_source_location.GetColumn()++;
         }
     }
 
@@ -3,6 +3,14 @@
 #include <script/compiler/ast/AstBinaryExpression.hpp>
 #include <script/compiler/ast/AstVariable.hpp>
 #include <script/compiler/ast/AstConstant.hpp>
+#include <script/compiler/ast/AstMember.hpp>
+#include <script/compiler/ast/AstMemberCallExpression.hpp>
+#include <script/compiler/ast/AstUnaryExpression.hpp>
+#include <script/compiler/ast/AstFunctionExpression.hpp>
+#include <script/compiler/ast/AstArgument.hpp>
+#include <script/compiler/ArrayBoundsAnalyzer.hpp>
+#include <script/compiler/ConstantEvaluator.hpp>
+#include <script/compiler/Configuration.hpp>
 
 #include <system/Debug.hpp>
 
@@ -63,6 +71,198 @@ RC<AstExpression> Optimizer::OptimizeExpr(
     return expr;
 }
 
+static RC<AstFunctionExpression> GetDirectFunction(const RC<AstExpression> &value, SizeType num_args)
+{
+    if (value == nullptr || !dynamic_cast<AstFunctionExpression *>(value.Get())) {
+        return nullptr;
+    }
+
+    RC<AstFunctionExpression> function_expr = RC<AstExpression>(value).CastUnsafe<AstFunctionExpression>();
+
+    if (function_expr->IsClosure() || function_expr->IsGenerator() || function_expr->IsConstructorDefinition()) {
+        return nullptr;
+    }
+
+    if (function_expr->GetParameters().Size() != num_args) {
+        return nullptr;
+    }
+
+    for (const RC<AstParameter> &param : function_expr->GetParameters()) {
+        if (param == nullptr || param->GetIdentifier() == nullptr) {
+            return nullptr;
+        }
+
+        if (param->IsVariadic() || param->IsRef() || param->IsGenericParam()) {
+            return nullptr;
+        }
+    }
+
+    return function_expr;
+}
+
+static bool IsInlineableExpression(const AstExpression *expr, SizeType &size)
+{
+    if (expr == nullptr || ++size > Config::max_inline_function_size) {
+        return false;
+    }
+
+    if (dynamic_cast<const AstConstant *>(expr)) {
+        return true;
+    }
+
+    if (dynamic_cast<const AstVariable *>(expr)) {
+        // the only locals a non-closure function can see are its own parameters
+        return true;
+    }
+
+    if (dynamic_cast<const AstMemberCallExpression *>(expr)) {
+        return false;
+    }
+
+    if (const AstMember *expr_as_member = dynamic_cast<const AstMember *>(expr)) {
+        return IsInlineableExpression(expr_as_member->GetTarget(), size);
+    }
+
+    if (const AstUnaryExpression *expr_as_unop = dynamic_cast<const AstUnaryExpression *>(expr)) {
+        return IsInlineableExpression(expr_as_unop->GetOperand().Get(), size);
+    }
+
+    if (const AstBinaryExpression *expr_as_binop = dynamic_cast<const AstBinaryExpression *>(expr)) {
+        // operator overloads are calls
+        if (expr_as_binop->GetOperatorOverload() != nullptr) {
+            return false;
+        }
+
+        return IsInlineableExpression(expr_as_binop->GetLeft().Get(), size)
+            && (expr_as_binop->GetRight() == nullptr || IsInlineableExpression(expr_as_binop->GetRight().Get(), size));
+    }
+
+    return false;
+}
+
+RC<AstFunctionExpression> Optimizer::FindInlineFunction(
+    const RC<AstExpression> &target,
+    SizeType num_args)
+{
+#if HYP_SCRIPT_ENABLE_FUNCTION_INLINING
+    AssertThrow(target != nullptr);
+
+    // only targets whose binding cannot change are inlined. a method called on an object
+    // is looked up on the object itself at runtime, and may have been reassigned.
+    const RC<AstFunctionExpression> function_expr = FindConstFunction(target, num_args);
+
+    if (function_expr == nullptr) {
+        return nullptr;
+    }
+
+    const RC<AstExpression> body_expr = function_expr->GetBodyExpression();
+    SizeType size = 0;
+
+    if (!IsInlineableExpression(body_expr.Get(), size)) {
+        return nullptr;
+    }
+
+    return function_expr;
+#else
+    return nullptr;
+#endif
+}
+
+RC<AstFunctionExpression> Optimizer::FindConstFunction(
+    const RC<AstExpression> &target,
+    SizeType num_args)
+{
+    AssertThrow(target != nullptr);
+
+    if (const AstIdentifier *target_as_identifier = dynamic_cast<AstIdentifier *>(target.Get())) {
+        if (const RC<Identifier> &ident = target_as_identifier->GetProperties().GetIdentifier()) {
+            if ((ident->GetFlags() & IdentifierFlags::FLAG_CONST) && !(ident->GetFlags() & IdentifierFlags::FLAG_ARGUMENT)) {
+                return GetDirectFunction(ident->GetCurrentValue(), num_args);
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+RC<AstConstant> Optimizer::EvaluateCall(
+    const RC<AstExpression> &target,
+    const Array<RC<AstArgument>> &args,
+    AstVisitor *visitor)
+{
+#if HYP_SCRIPT_ENABLE_COMPILE_TIME_EVALUATION
+    AssertThrow(target != nullptr);
+
+    Array<RC<AstConstant>> arg_values;
+    arg_values.Reserve(args.Size());
+
+    // checking the arguments first is cheap, and rules out most calls
+    for (const RC<AstArgument> &arg : args) {
+        if (arg == nullptr || arg->GetExpr() == nullptr || arg->IsSplat()) {
+            return nullptr;
+        }
+
+        const AstConstant *arg_as_constant = dynamic_cast<const AstConstant *>(arg->GetExpr()->GetValueOf());
+
+        if (arg_as_constant == nullptr) {
+            return nullptr;
+        }
+
+        arg_values.PushBack(CloneAstNode(arg_as_constant));
+    }
+
+    const RC<AstFunctionExpression> function_expr = FindConstFunction(target, args.Size());
+
+    if (function_expr == nullptr) {
+        return nullptr;
+    }
+
+    ConstantEvaluator evaluator;
+
+    return evaluator.Call(function_expr.Get(), arg_values);
+#else
+    return nullptr;
+#endif
+}
+
+Int Optimizer::FindNativeFunction(const RC<AstExpression> &target)
+{
+#if HYP_SCRIPT_ENABLE_DIRECT_NATIVE_CALLS
+    AssertThrow(target != nullptr);
+
+    if (const AstIdentifier *target_as_identifier = dynamic_cast<AstIdentifier *>(target.Get())) {
+        if (const RC<Identifier> &ident = target_as_identifier->GetProperties().GetIdentifier()) {
+            // native globals are const, so the identifier always refers to the bound function
+            if ((ident->GetFlags() & IdentifierFlags::FLAG_CONST) && (ident->GetFlags() & IdentifierFlags::FLAG_NATIVE)) {
+                const Int index = ident->GetNativeFunctionIndex();
+
+                // CALL_NATIVE holds a 16-bit index
+                if (index <= Int(MathUtil::MaxSafeValue<UInt16>())) {
+                    return index;
+                }
+            }
+        }
+    }
+#endif
+
+    return -1;
+}
+
+SizeType Optimizer::EliminateArrayBoundsChecks(
+    const AstStatement *counter_decl,
+    const AstExpression *condition,
+    const AstExpression *increment,
+    const AstBlock *block)
+{
+#if HYP_SCRIPT_ENABLE_ARRAY_BOUNDS_CHECK_ELIMINATION
+    ArrayBoundsAnalyzer analyzer;
+
+    return analyzer.Analyze(counter_decl, condition, increment, block);
+#else
+    return 0;
+#endif
+}
+
 Optimizer::Optimizer(AstIterator *ast_iterator, CompilationUnit *compilation_unit)
     : AstVisitor(ast_iterator, compilation_unit)
 {
@@ -12,6 +12,10 @@ namespace hyperion::compiler {
 
 // forward declarations
 class AstConstant;
+class AstFunctionExpression;
+class AstArgument;
+class AstStatement;
+class AstBlock;
 
 class Optimizer : public AstVisitor {
 public:
@@ -28,6 +32,39 @@ public:
         AstVisitor *visitor,
         Module *mod);
 
+    /** Finds the function that a call to the target may be replaced with the body of.
+        The target must be a const function, and the function body must be a single small
+        expression that makes no calls. */
+    static RC<AstFunctionExpression> FindInlineFunction(
+        const RC<AstExpression> &target,
+        SizeType num_args);
+
+    /** Finds the function that the target always refers to: a const identifier holding a function
+        that is not a closure, generator or constructor, and takes num_args plain parameters. */
+    static RC<AstFunctionExpression> FindConstFunction(
+        const RC<AstExpression> &target,
+        SizeType num_args);
+
+    /** Attempts to evaluate a call to a pure function with constant arguments at compile-time.
+        Returns the value the call would return, or null if it cannot be evaluated. */
+    static RC<AstConstant> EvaluateCall(
+        const RC<AstExpression> &target,
+        const Array<RC<AstArgument>> &args,
+        AstVisitor *visitor);
+
+    /** Finds the index into the native function table of the native function the target refers to,
+        so the call can be made with CALL_NATIVE. Returns -1 if the target is not a bound native global. */
+    static Int FindNativeFunction(const RC<AstExpression> &target);
+
+    /** Marks the accesses to an array in a loop over its length that are always in range, so that they
+        are built without a call to operator[] or a bounds check. Must be run before the loop is optimized.
+        Increment is null for a while loop. Returns the number of accesses that were marked. */
+    static SizeType EliminateArrayBoundsChecks(
+        const AstStatement *counter_decl,
+        const AstExpression *condition,
+        const AstExpression *increment,
+        const AstBlock *block);
+
 public:
     Optimizer(AstIterator *ast_iterator,
         CompilationUnit *compilation_unit);
@@ -0,0 +1,67 @@
+#include <script/compiler/ParseCache.hpp>
+
+namespace hyperion::compiler {
+
+bool ParseCache::Get(
+    const String &filepath,
+    HashCode::ValueType content_hash,
+    AstIterator &out_ast_iterator,
+    ErrorList &out_errors
+) const
+{
+    Array<RC<AstStatement>> statements;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        const auto it = m_entries.Find(filepath);
+
+        if (it == m_entries.End() || it->second.content_hash != content_hash) {
+            return false;
+        }
+
+        statements = it->second.statements;
+        out_errors = it->second.errors;
+    }
+
+    // cloning is the expensive part, so it is done without holding the lock
+    for (const RC<AstStatement> &stmt : statements) {
+        out_ast_iterator.Push(CloneAstNode(stmt));
+    }
+
+    return true;
+}
+
+void ParseCache::Set(
+    const String &filepath,
+    HashCode::ValueType content_hash,
+    const AstIterator &ast_iterator,
+    const ErrorList &errors
+)
+{
+    Entry entry {
+        content_hash,
+        CloneAllAstNodes(ast_iterator.GetStatements()),
+        errors
+    };
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_entries.Set(filepath, std::move(entry));
+}
+
+void ParseCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_entries.Clear();
+}
+
+SizeType ParseCache::Size() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    return m_entries.Size();
+}
+
+} // namespace hyperion::compiler
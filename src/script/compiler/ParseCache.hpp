@@ -0,0 +1,68 @@
+#ifndef PARSE_CACHE_HPP
+#define PARSE_CACHE_HPP
+
+#include <script/compiler/AstIterator.hpp>
+#include <script/compiler/ErrorList.hpp>
+
+#include <core/lib/String.hpp>
+#include <core/lib/HashMap.hpp>
+#include <core/lib/DynArray.hpp>
+
+#include <HashCode.hpp>
+#include <Types.hpp>
+
+#include <mutex>
+
+namespace hyperion::compiler {
+
+/*! \brief Keeps the parsed statements of imported files between compilations, so that a file whose
+    contents have not changed does not have to be lexed and parsed again when a script is recompiled.
+
+    Entries are keyed by the path the file was read as, and are only used while the hash of the
+    file's contents matches. Semantic analysis modifies the AST, so the cache holds its own copy of
+    the statements, as they were before analysis, and hands out clones of them.
+    May be used from several threads at once. */
+class ParseCache
+{
+public:
+    ParseCache() = default;
+    ParseCache(const ParseCache &other) = delete;
+    ParseCache &operator=(const ParseCache &other) = delete;
+    ~ParseCache() = default;
+
+    /*! \brief If the file was cached with the same content hash, appends a clone of its statements to
+        \ref{out_ast_iterator}, copies the errors its parse reported to \ref{out_errors} and returns true. */
+    bool Get(
+        const String &filepath,
+        HashCode::ValueType content_hash,
+        AstIterator &out_ast_iterator,
+        ErrorList &out_errors
+    ) const;
+
+    /*! \brief Stores a clone of the given statements. Must be called before they are analyzed. */
+    void Set(
+        const String &filepath,
+        HashCode::ValueType content_hash,
+        const AstIterator &ast_iterator,
+        const ErrorList &errors
+    );
+
+    void Clear();
+
+    SizeType Size() const;
+
+private:
+    struct Entry
+    {
+        HashCode::ValueType     content_hash;
+        Array<RC<AstStatement>> statements;
+        ErrorList               errors;
+    };
+
+    mutable std::mutex      m_mutex;
+    HashMap<String, Entry>  m_entries;
+};
+
+} // namespace hyperion::compiler
+
+#endif
@@ -32,9 +32,9 @@ Parser::Parser(const Parser &other)
 {
 }
 
-Token Parser::Match(TokenClass token_class, Bool read)
+const Token &Parser::Match(TokenClass token_class, Bool read)
 {
-    Token peek = m_token_stream->Peek();
+    const Token &peek = m_token_stream->Peek();
     
     if (peek && peek.GetTokenClass() == token_class) {
         if (read && m_token_stream->HasNext()) {
@@ -47,9 +47,9 @@ Token Parser::Match(TokenClass token_class, Bool read)
     return Token::EMPTY;
 }
 
-Token Parser::MatchAhead(TokenClass token_class, Int n)
+const Token &Parser::MatchAhead(TokenClass token_class, Int n)
 {
-    Token peek = m_token_stream->Peek(n);
+    const Token &peek = m_token_stream->Peek(n);
     
     if (peek && peek.GetTokenClass() == token_class) {
         return peek;
@@ -58,9 +58,9 @@ Token Parser::MatchAhead(TokenClass token_class, Int n)
     return Token::EMPTY;
 }
 
-Token Parser::MatchKeyword(Keywords keyword, Bool read)
+const Token &Parser::MatchKeyword(Keywords keyword, Bool read)
 {
-    Token peek = m_token_stream->Peek();
+    const Token &peek = m_token_stream->Peek();
     
     if (peek && peek.GetTokenClass() == TK_KEYWORD) {
         auto str = Keyword::ToString(keyword);
@@ -77,9 +77,9 @@ Token Parser::MatchKeyword(Keywords keyword, Bool read)
     return Token::EMPTY;
 }
 
-Token Parser::MatchKeywordAhead(Keywords keyword, Int n)
+const Token &Parser::MatchKeywordAhead(Keywords keyword, Int n)
 {
-    Token peek = m_token_stream->Peek(n);
+    const Token &peek = m_token_stream->Peek(n);
     
     if (peek && peek.GetTokenClass() == TK_KEYWORD) {
         auto str = Keyword::ToString(keyword);
@@ -92,9 +92,9 @@ Token Parser::MatchKeywordAhead(Keywords keyword, Int n)
     return Token::EMPTY;
 }
 
-Token Parser::MatchOperator(const String &op, Bool read)
+const Token &Parser::MatchOperator(const String &op, Bool read)
 {
-    Token peek = m_token_stream->Peek();
+    const Token &peek = m_token_stream->Peek();
     
     if (peek && peek.GetTokenClass() == TK_OPERATOR) {
         if (peek.GetValue() == op) {
@@ -109,9 +109,9 @@ Token Parser::MatchOperator(const String &op, Bool read)
     return Token::EMPTY;
 }
 
-Token Parser::MatchOperatorAhead(const String &op, Int n)
+const Token &Parser::MatchOperatorAhead(const String &op, Int n)
 {
-    Token peek = m_token_stream->Peek(n);
+    const Token &peek = m_token_stream->Peek(n);
     
     if (peek && peek.GetTokenClass() == TK_OPERATOR) {
         if (peek.GetValue() == op) {
@@ -122,9 +122,9 @@ Token Parser::MatchOperatorAhead(const String &op, Int n)
     return Token::EMPTY;
 }
 
-Token Parser::Expect(TokenClass token_class, Bool read)
+const Token &Parser::Expect(TokenClass token_class, Bool read)
 {
-    Token token = Match(token_class, read);
+    const Token &token = Match(token_class, read);
     
     if (!token) {
         const SourceLocation location = CurrentLocation();
@@ -152,9 +152,9 @@ Token Parser::Expect(TokenClass token_class, Bool read)
     return token;
 }
 
-Token Parser::ExpectKeyword(Keywords keyword, Bool read)
+const Token &Parser::ExpectKeyword(Keywords keyword, Bool read)
 {
-    Token token = MatchKeyword(keyword, read);
+    const Token &token = MatchKeyword(keyword, read);
     
     if (!token) {
         const SourceLocation location = CurrentLocation();
@@ -189,9 +189,9 @@ Token Parser::ExpectKeyword(Keywords keyword, Bool read)
     return token;
 }
 
-Token Parser::ExpectOperator(const String &op, Bool read)
+const Token &Parser::ExpectOperator(const String &op, Bool read)
 {
-    Token token = MatchOperator(op, read);
+    const Token &token = MatchOperator(op, read);
 
     if (!token) {
         const SourceLocation location = CurrentLocation();
@@ -211,12 +211,12 @@ Token Parser::ExpectOperator(const String &op, Bool read)
     return token;
 }
 
-Token Parser::MatchIdentifier(Bool allow_keyword, Bool read)
+const Token &Parser::MatchIdentifier(Bool allow_keyword, Bool read)
 {
-    Token ident = Match(TK_IDENT, read);
+    const Token &ident = Match(TK_IDENT, read);
 
     if (!ident) {
-        Token kw = Match(TK_KEYWORD, read);
+        const Token &kw = Match(TK_KEYWORD, read);
         
         if (kw) {
             if (allow_keyword) {
@@ -238,9 +238,9 @@ Token Parser::MatchIdentifier(Bool allow_keyword, Bool read)
     return ident;
 }
 
-Token Parser::ExpectIdentifier(Bool allow_keyword, Bool read)
+const Token &Parser::ExpectIdentifier(Bool allow_keyword, Bool read)
 {
-    Token kw = Match(TK_KEYWORD, read);
+    const Token &kw = Match(TK_KEYWORD, read);
 
     if (!kw) {
         // keyword not found, so must be identifier
@@ -424,6 +424,8 @@ RC<AstStatement> Parser::ParseStatement(
             res = ParseTryCatchStatement();
         } else if (MatchKeyword(Keyword_return, false)) {
             res = ParseReturnStatement();
+        } else if (MatchKeyword(Keyword_yield, false)) {
+            res = ParseYieldStatement();
         } else {
             res = ParseExpression();
         }
@@ -2802,6 +2804,26 @@ RC<AstReturnStatement> Parser::ParseReturnStatement()
     return nullptr;
 }
 
+RC<AstYieldStatement> Parser::ParseYieldStatement()
+{
+    const SourceLocation location = CurrentLocation();
+
+    if (Token token = ExpectKeyword(Keyword_yield, true)) {
+        RC<AstExpression> expr;
+
+        if (!Match(TK_SEMICOLON, false) && !Match(TK_NEWLINE, false) && !Match(TK_CLOSE_BRACE, false)) {
+            expr = ParseExpression();
+        }
+
+        return RC<AstYieldStatement>(new AstYieldStatement(
+            expr,
+            location
+        ));
+    }
+
+    return nullptr;
+}
+
 RC<AstExpression> Parser::ParseMetaProperty()
 {
     const SourceLocation location = CurrentLocation();
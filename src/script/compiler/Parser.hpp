@@ -57,6 +57,7 @@
 #include <script/compiler/ast/AstPrototypeSpecification.hpp>
 #include <script/compiler/ast/AstTypeOfExpression.hpp>
 #include <script/compiler/ast/AstReturnStatement.hpp>
+#include <script/compiler/ast/AstYieldStatement.hpp>
 #include <script/compiler/ast/AstSymbolQuery.hpp>
 #include <script/compiler/ast/AstTemplateExpression.hpp>
 #include <script/compiler/ast/AstTemplateInstantiation.hpp>
@@ -184,6 +185,7 @@ public:
     RC<AstModuleImport> ParseModuleImport();
     RC<AstModuleImportPart> ParseModuleImportPart(Bool allow_braces = false);
     RC<AstReturnStatement> ParseReturnStatement();
+    RC<AstYieldStatement> ParseYieldStatement();
     RC<AstExpression> ParseMetaProperty();
 
 private:
@@ -193,17 +195,17 @@ private:
     TokenStream *m_token_stream;
     CompilationUnit *m_compilation_unit;
 
-    Token Match(TokenClass token_class, Bool read = false);
-    Token MatchAhead(TokenClass token_class, int n);
-    Token MatchKeyword(Keywords keyword, Bool read = false);
-    Token MatchKeywordAhead(Keywords keyword, int n);
-    Token MatchOperator(const String &op, Bool read = false);
-    Token MatchOperatorAhead(const String &op, int n);
-    Token Expect(TokenClass token_class, Bool read = false);
-    Token ExpectKeyword(Keywords keyword, Bool read = false);
-    Token ExpectOperator(const String &op, Bool read = false);
-    Token MatchIdentifier(Bool allow_keyword = false, Bool read = false);
-    Token ExpectIdentifier(Bool allow_keyword = false, Bool read = false);
+    const Token &Match(TokenClass token_class, Bool read = false);
+    const Token &MatchAhead(TokenClass token_class, int n);
+    const Token &MatchKeyword(Keywords keyword, Bool read = false);
+    const Token &MatchKeywordAhead(Keywords keyword, int n);
+    const Token &MatchOperator(const String &op, Bool read = false);
+    const Token &MatchOperatorAhead(const String &op, int n);
+    const Token &Expect(TokenClass token_class, Bool read = false);
+    const Token &ExpectKeyword(Keywords keyword, Bool read = false);
+    const Token &ExpectOperator(const String &op, Bool read = false);
+    const Token &MatchIdentifier(Bool allow_keyword = false, Bool read = false);
+    const Token &ExpectIdentifier(Bool allow_keyword = false, Bool read = false);
     Bool ExpectEndOfStmt();
     SourceLocation CurrentLocation() const;
     void SkipStatementTerminators();
@@ -149,7 +149,8 @@ enum ScopeFunctionFlags : int
     CONSTRUCTOR_DEFINITION_FLAG = 0x10,
     REF_VARIABLE_FLAG           = 0x20,
     CONST_VARIABLE_FLAG         = 0x40,
-    ENUM_MEMBERS_FLAG           = 0x80
+    ENUM_MEMBERS_FLAG           = 0x80,
+    TRY_BLOCK_FLAG              = 0x100
 };
 
 class Scope
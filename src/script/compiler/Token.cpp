@@ -63,6 +63,14 @@ Token::Token(const Token &other)
     std::memcpy(m_flags, other.m_flags, sizeof(m_flags));
 }
 
+Token::Token(Token &&other) noexcept
+    : m_token_class(other.m_token_class),
+      m_value(std::move(other.m_value)),
+      m_location(std::move(other.m_location))
+{
+    std::memcpy(m_flags, other.m_flags, sizeof(m_flags));
+}
+
 bool Token::IsContinuationToken() const
 {
     return m_token_class == TK_DIRECTIVE ||
@@ -63,6 +63,7 @@ public:
     );
 
     Token(const Token &other);
+    Token(Token &&other) noexcept;
 
     TokenClass GetTokenClass() const { return m_token_class; }
     const String &GetValue() const { return m_value; }
@@ -32,7 +32,9 @@ public:
     TokenStream(const TokenStreamInfo &info);
     TokenStream(const TokenStream &other) = delete;
     
-    Token Peek(int n = 0) const
+    /*! \brief Returns a reference to the token \ref{n} positions ahead, or Token::EMPTY if past the end.
+        The reference remains valid as long as no more tokens are pushed. */
+    const Token &Peek(int n = 0) const
     {
         SizeType pos = m_position + n;
 
@@ -44,9 +46,10 @@ public:
     }
 
     void Push(const Token &token) { m_tokens.PushBack(token); }
+    void Push(Token &&token) { m_tokens.PushBack(std::move(token)); }
     bool HasNext() const { return m_position < m_tokens.Size(); }
-    Token Next() { AssertThrow(m_position < m_tokens.Size()); return m_tokens[m_position++]; }
-    Token Last() const { AssertThrow(!m_tokens.Empty()); return m_tokens.Back(); }
+    const Token &Next() { AssertThrow(m_position < m_tokens.Size()); return m_tokens[m_position++]; }
+    const Token &Last() const { AssertThrow(!m_tokens.Empty()); return m_tokens.Back(); }
     SizeType GetSize() const { return m_tokens.Size(); }
     SizeType GetPosition() const { return m_position; }
     const TokenStreamInfo &GetInfo() const { return m_info; }
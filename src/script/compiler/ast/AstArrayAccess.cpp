@@ -176,6 +176,10 @@ void AstArrayAccess::Visit(AstVisitor *visitor, Module *mod)
 
 std::unique_ptr<Buildable> AstArrayAccess::Build(AstVisitor *visitor, Module *mod)
 {
+    if (m_is_in_bounds) {
+        return BuildInBounds(visitor, mod);
+    }
+
     if (m_override_expr != nullptr) {
         return m_override_expr->Build(visitor, mod);
     }
@@ -249,9 +253,63 @@ std::unique_ptr<Buildable> AstArrayAccess::Build(AstVisitor *visitor, Module *mo
     return chunk;
 }
 
+std::unique_ptr<Buildable> AstArrayAccess::BuildInBounds(AstVisitor *visitor, Module *mod)
+{
+    // the target and index are both plain variables, so loading them has no side effects
+    AssertThrow(m_target != nullptr);
+    AssertThrow(m_index != nullptr);
+
+    std::unique_ptr<BytecodeChunk> chunk = BytecodeUtil::Make<BytecodeChunk>();
+
+    UInt8 src = 0;
+
+    if (m_rhs != nullptr) {
+        chunk->Append(m_rhs->Build(visitor, mod));
+
+        // keep the value to store while the array and index are loaded
+        src = visitor->GetCompilationUnit()->GetInstructionStream().GetCurrentRegister();
+        visitor->GetCompilationUnit()->GetInstructionStream().IncRegisterUsage();
+    }
+
+    Compiler::ExprInfo info {
+        m_target.Get(),
+        m_index.Get()
+    };
+
+    chunk->Append(Compiler::LoadLeftThenRight(visitor, mod, info));
+
+    const UInt8 r1 = visitor->GetCompilationUnit()->GetInstructionStream().GetCurrentRegister();
+
+    // unclaim register
+    const UInt8 r0 = visitor->GetCompilationUnit()->GetInstructionStream().DecRegisterUsage();
+
+    if (m_rhs != nullptr) {
+        auto instr = BytecodeUtil::Make<RawOperation<>>();
+        instr->opcode = MOV_ARRAYIDX_UNCHECKED;
+        instr->Accept<UInt8>(r0); // destination
+        instr->Accept<UInt8>(r1); // index
+        instr->Accept<UInt8>(src); // source
+
+        chunk->Append(std::move(instr));
+
+        // the stored value is left as the result
+        visitor->GetCompilationUnit()->GetInstructionStream().DecRegisterUsage();
+    } else {
+        auto instr = BytecodeUtil::Make<RawOperation<>>();
+        instr->opcode = LOAD_ARRAYIDX_UNCHECKED;
+        instr->Accept<UInt8>(r0); // destination
+        instr->Accept<UInt8>(r0); // source
+        instr->Accept<UInt8>(r1); // index
+
+        chunk->Append(std::move(instr));
+    }
+
+    return chunk;
+}
+
 void AstArrayAccess::Optimize(AstVisitor *visitor, Module *mod)
 {
-    if (m_override_expr != nullptr) {
+    if (m_override_expr != nullptr && !m_is_in_bounds) {
         m_override_expr->Optimize(visitor, mod);
 
         return;
@@ -262,6 +320,10 @@ void AstArrayAccess::Optimize(AstVisitor *visitor, Module *mod)
 
     m_target->Optimize(visitor, mod);
     m_index->Optimize(visitor, mod);
+
+    if (m_rhs != nullptr) {
+        m_rhs->Optimize(visitor, mod);
+    }
 }
 
 RC<AstStatement> AstArrayAccess::Clone() const
@@ -26,6 +26,24 @@ public:
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
 
+    const RC<AstExpression> &GetArrayTarget() const
+        { return m_target; }
+
+    const RC<AstExpression> &GetIndex() const
+        { return m_index; }
+
+    const RC<AstExpression> &GetRhs() const
+        { return m_rhs; }
+
+    /*! \brief Has the index been proven to be in range of the array? If so, the access is built
+        as LOAD_ARRAYIDX_UNCHECKED / MOV_ARRAYIDX_UNCHECKED rather than a call to operator[].
+        Set by the optimizer before the access is optimized. */
+    bool IsInBounds() const
+        { return m_is_in_bounds; }
+
+    void SetIsInBounds(bool is_in_bounds)
+        { m_is_in_bounds = is_in_bounds; }
+
     bool IsOperatorOverloadingEnabled() const
         { return m_operator_overloading_enabled; }
 
@@ -59,10 +77,13 @@ private:
     RC<AstExpression>   m_index;
     RC<AstExpression>   m_rhs;
     bool                m_operator_overloading_enabled;
+    bool                m_is_in_bounds = false;
 
     // set while analyzing
     RC<AstExpression>   m_override_expr;
 
+    std::unique_ptr<Buildable> BuildInBounds(AstVisitor *visitor, Module *mod);
+
     RC<AstArrayAccess> CloneImpl() const
     {
         return RC<AstArrayAccess>(new AstArrayAccess(
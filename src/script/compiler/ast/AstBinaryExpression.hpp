@@ -20,6 +20,10 @@ public:
 
     const RC<AstExpression> &GetLeft() const { return m_left; }
     const RC<AstExpression> &GetRight() const { return m_right; }
+    const Operator *GetOperator() const { return m_op; }
+
+    const RC<AstExpression> &GetOperatorOverload() const
+        { return m_operator_overload; }
 
     bool IsOperatorOverloadingEnabled() const
         { return m_operator_overloading_enabled; }
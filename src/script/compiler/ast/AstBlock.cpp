@@ -1,7 +1,9 @@
 #include <script/compiler/ast/AstBlock.hpp>
 #include <script/compiler/Compiler.hpp>
 #include <script/compiler/AstVisitor.hpp>
+#include <script/compiler/Optimizer.hpp>
 #include <script/compiler/ast/AstReturnStatement.hpp>
+#include <script/compiler/ast/AstWhileLoop.hpp>
 
 #include <script/compiler/emit/BytecodeChunk.hpp>
 #include <script/compiler/emit/BytecodeUtil.hpp>
@@ -91,6 +93,18 @@ std::unique_ptr<Buildable> AstBlock::Build(AstVisitor *visitor, Module *mod)
 
 void AstBlock::Optimize(AstVisitor *visitor, Module *mod)
 {
+    // a while loop directly after the declaration of its counter may be a loop over an array
+    for (SizeType index = 1; index < m_children.Size(); index++) {
+        if (const AstWhileLoop *while_loop = dynamic_cast<const AstWhileLoop *>(m_children[index].Get())) {
+            Optimizer::EliminateArrayBoundsChecks(
+                m_children[index - 1].Get(),
+                while_loop->GetConditional().Get(),
+                nullptr,
+                while_loop->GetBlock().Get()
+            );
+        }
+    }
+
     for (auto &child : m_children) {
         if (child) {
             child->Optimize(visitor, mod);
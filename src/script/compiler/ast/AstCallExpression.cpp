@@ -3,6 +3,9 @@
 #include <script/compiler/AstVisitor.hpp>
 #include <script/compiler/ast/AstMember.hpp>
 #include <script/compiler/ast/AstNewExpression.hpp>
+#include <script/compiler/ast/AstFunctionExpression.hpp>
+#include <script/compiler/ast/AstConstant.hpp>
+#include <script/compiler/Optimizer.hpp>
 #include <script/compiler/SemanticAnalyzer.hpp>
 #include <script/compiler/Keywords.hpp>
 
@@ -190,6 +193,10 @@ std::unique_ptr<Buildable> AstCallExpression::Build(AstVisitor *visitor, Module
     if (m_override_expr != nullptr) {
         return m_override_expr->Build(visitor, mod);
     }
+
+    if (m_folded_value != nullptr) {
+        return m_folded_value->Build(visitor, mod);
+    }
     
     std::unique_ptr<BytecodeChunk> chunk = BytecodeUtil::Make<BytecodeChunk>();
 
@@ -200,14 +207,37 @@ std::unique_ptr<Buildable> AstCallExpression::Build(AstVisitor *visitor, Module
         m_substituted_args
     ));
 
+    if (m_inline_function != nullptr) {
+        // the arguments stay on the stack as the parameters of the inlined body
+        chunk->Append(m_inline_function->BuildInline(visitor, mod));
+
+        chunk->Append(Compiler::BuildArgumentsEnd(
+            visitor,
+            mod,
+            m_substituted_args.Size()
+        ));
+
+        return chunk;
+    }
+
     const Int stack_size_before = visitor->GetCompilationUnit()->GetInstructionStream().GetStackSize();
 
-    chunk->Append(Compiler::BuildCall(
-        visitor,
-        mod,
-        m_expr,
-        UInt8(m_substituted_args.Size())
-    ));
+    if (m_native_function_index != -1) {
+        chunk->Append(Compiler::BuildNativeCall(
+            visitor,
+            mod,
+            UInt16(m_native_function_index),
+            UInt8(m_substituted_args.Size())
+        ));
+    } else {
+        chunk->Append(Compiler::BuildCall(
+            visitor,
+            mod,
+            m_expr,
+            UInt8(m_substituted_args.Size()),
+            m_is_tail_call
+        ));
+    }
 
     const Int stack_size_now = visitor->GetCompilationUnit()->GetInstructionStream().GetStackSize();
 
@@ -241,6 +271,38 @@ void AstCallExpression::Optimize(AstVisitor *visitor, Module *mod)
             arg->Optimize(visitor, visitor->GetCompilationUnit()->GetCurrentModule());
         }
     }
+
+    AssertThrow(m_expr != nullptr);
+
+    m_folded_value = Optimizer::EvaluateCall(m_expr, m_substituted_args, visitor);
+
+    if (m_folded_value != nullptr) {
+        if (const AstIdentifier *expr_as_identifier = dynamic_cast<AstIdentifier *>(m_expr.Get())) {
+            // the function is not called at all, the result is loaded as a constant
+            if (const RC<Identifier> &ident = expr_as_identifier->GetProperties().GetIdentifier()) {
+                ident->DecUseCount();
+            }
+        }
+
+        return;
+    }
+
+    m_inline_function = Optimizer::FindInlineFunction(m_expr, m_substituted_args.Size());
+
+    if (m_inline_function != nullptr) {
+        if (const AstIdentifier *expr_as_identifier = dynamic_cast<AstIdentifier *>(m_expr.Get())) {
+            // the function itself is no longer loaded for this call
+            if (const RC<Identifier> &ident = expr_as_identifier->GetProperties().GetIdentifier()) {
+                ident->DecUseCount();
+            }
+        }
+
+        return;
+    }
+
+    // native globals are called through the VM's native function table instead of being loaded.
+    // their declarations are always built, so the use count is left alone
+    m_native_function_index = Optimizer::FindNativeFunction(m_expr);
 }
 
 RC<AstStatement> AstCallExpression::Clone() const
@@ -254,6 +316,10 @@ Tribool AstCallExpression::IsTrue() const
         return m_override_expr->IsTrue();
     }
 
+    if (m_folded_value != nullptr) {
+        return m_folded_value->IsTrue();
+    }
+
     // cannot deduce if return value is true
     return Tribool::Indeterminate();
 }
@@ -264,6 +330,10 @@ bool AstCallExpression::MayHaveSideEffects() const
         return m_override_expr->MayHaveSideEffects();
     }
 
+    if (m_folded_value != nullptr) {
+        return false;
+    }
+
     // assume a function call has side effects
     // maybe we could detect this later
     return true;
@@ -288,4 +358,22 @@ AstExpression *AstCallExpression::GetTarget() const
     return AstExpression::GetTarget();
 }
 
+const AstExpression *AstCallExpression::GetValueOf() const
+{
+    if (m_folded_value != nullptr) {
+        return m_folded_value.Get();
+    }
+
+    return AstExpression::GetValueOf();
+}
+
+const AstExpression *AstCallExpression::GetDeepValueOf() const
+{
+    if (m_folded_value != nullptr) {
+        return m_folded_value.Get();
+    }
+
+    return AstExpression::GetDeepValueOf();
+}
+
 } // namespace hyperion::compiler
@@ -10,6 +10,9 @@
 
 namespace hyperion::compiler {
 
+class AstFunctionExpression;
+class AstConstant;
+
 class AstCallExpression : public AstExpression
 {
 public:
@@ -21,6 +24,17 @@ public:
     );
     virtual ~AstCallExpression() = default;
 
+    const RC<AstExpression> &GetExpr() const
+        { return m_expr; }
+
+    /*! \brief Set when the call is replaced by another expression, such as a call to '$invoke'. */
+    const RC<AstExpression> &GetOverrideExpr() const
+        { return m_override_expr; }
+
+    /*! \brief The arguments in parameter order, with default values filled in. Set by Visit(). */
+    const Array<RC<AstArgument>> &GetSubstitutedArguments() const
+        { return m_substituted_args; }
+
     Array<RC<AstArgument>> &GetArguments()
         { return m_args; }
 
@@ -30,6 +44,13 @@ public:
     const SymbolTypePtr_t &GetReturnType() const
         { return m_return_type; }
 
+    /*! \brief Set by a return statement when this call is the value it returns. */
+    bool IsTailCall() const
+        { return m_is_tail_call; }
+
+    void SetIsTailCall(bool is_tail_call)
+        { m_is_tail_call = is_tail_call; }
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
@@ -40,6 +61,8 @@ public:
     virtual bool MayHaveSideEffects() const override;
     virtual SymbolTypePtr_t GetExprType() const override;
     virtual AstExpression *GetTarget() const override;
+    virtual const AstExpression *GetValueOf() const override;
+    virtual const AstExpression *GetDeepValueOf() const override;
 
     virtual HashCode GetHashCode() const override
     {
@@ -65,6 +88,12 @@ protected:
     Array<RC<AstArgument>>  m_substituted_args;
     SymbolTypePtr_t         m_return_type;
     bool                    m_is_visited = false;
+    bool                    m_is_tail_call = false;
+
+    // set while optimizing
+    RC<AstFunctionExpression> m_inline_function;
+    RC<AstConstant>           m_folded_value;
+    Int                       m_native_function_index = -1;
 
     RC<AstCallExpression> CloneImpl() const
     {
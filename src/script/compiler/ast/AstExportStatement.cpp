@@ -1,4 +1,5 @@
 #include <script/compiler/ast/AstExportStatement.hpp>
+#include <script/compiler/ast/AstDeclaration.hpp>
 #include <script/compiler/Optimizer.hpp>
 #include <script/compiler/AstVisitor.hpp>
 #include <script/compiler/Compiler.hpp>
@@ -48,6 +49,13 @@ void AstExportStatement::Visit(AstVisitor *visitor, Module *mod)
         return;
     }
 
+    // exported symbols may be used by the host, so they are always reachable
+    if (const AstDeclaration *decl = dynamic_cast<const AstDeclaration *>(m_stmt.Get())) {
+        if (decl->GetIdentifier() != nullptr) {
+            decl->GetIdentifier()->AddUser(nullptr);
+        }
+    }
+
     // TODO: ensure thing not already exported globally (or in module?)
 }
 
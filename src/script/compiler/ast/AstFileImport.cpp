@@ -22,7 +22,7 @@ AstFileImport::AstFileImport(
 {
 }
 
-void AstFileImport::Visit(AstVisitor *visitor, Module *mod)
+String AstFileImport::GetFilePath() const
 {
     // find the folder which the current file is in
     std::string dir = m_location.GetFileName().Data();
@@ -33,12 +33,15 @@ void AstFileImport::Visit(AstVisitor *visitor, Module *mod)
     }
 
     // create relative path
-    String filepath = String(dir.c_str()) + m_path;
+    return String(dir.c_str()) + m_path;
+}
 
+void AstFileImport::Visit(AstVisitor *visitor, Module *mod)
+{
     AstImport::PerformImport(
         visitor,
         mod,
-        filepath
+        GetFilePath()
     );
 }
 
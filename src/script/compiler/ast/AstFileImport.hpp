@@ -19,6 +19,9 @@ public:
 
     const String &GetPath() const { return m_path; }
 
+    /*! \brief The path of the file to import, relative to the file this import is in. */
+    String GetFilePath() const;
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     
     virtual RC<AstStatement> Clone() const override;
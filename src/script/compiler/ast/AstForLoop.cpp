@@ -2,6 +2,7 @@
 #include <script/compiler/ast/AstTrue.hpp>
 #include <script/compiler/AstVisitor.hpp>
 #include <script/compiler/Compiler.hpp>
+#include <script/compiler/Optimizer.hpp>
 #include <script/compiler/ast/AstArgument.hpp>
 #include <script/compiler/emit/Instruction.hpp>
 #include <script/compiler/emit/StaticObject.hpp>
@@ -234,6 +235,14 @@ std::unique_ptr<Buildable> AstForLoop::Build(AstVisitor *visitor, Module *mod)
 
 void AstForLoop::Optimize(AstVisitor *visitor, Module *mod)
 {
+    // before the body is optimized, so accesses that are in range are optimized as such
+    Optimizer::EliminateArrayBoundsChecks(
+        m_decl_part.Get(),
+        m_condition_part.Get(),
+        m_increment_part.Get(),
+        m_block.Get()
+    );
+
     if (m_decl_part != nullptr) {
         m_decl_part->Optimize(visitor, mod);
     }
@@ -24,6 +24,18 @@ public:
     );
     virtual ~AstForLoop() override = default;
 
+    const RC<AstStatement> &GetDeclPart() const
+        { return m_decl_part; }
+
+    const RC<AstExpression> &GetConditionPart() const
+        { return m_condition_part; }
+
+    const RC<AstExpression> &GetIncrementPart() const
+        { return m_increment_part; }
+
+    const RC<AstBlock> &GetBlock() const
+        { return m_block; }
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
@@ -42,6 +42,7 @@ AstFunctionExpression::AstFunctionExpression(
     m_block(block),
     m_is_closure(false),
     m_is_constructor_definition(false),
+    m_is_generator(false),
     m_return_type(BuiltinTypes::ANY),
     m_static_id(0)
 {
@@ -150,8 +151,24 @@ void AstFunctionExpression::Visit(AstVisitor *visitor, Module *mod)
 
     const Scope *function_scope = &mod->m_scopes.Top();//m_block_with_parameters->GetScope();
     AssertThrow(function_scope != nullptr);
-    
-    if (function_scope->GetReturnTypes().Any()) {
+
+    // any 'yield' within the body turns this function into a generator.
+    m_is_generator = function_scope->GetScopeFlags() & GENERATOR_FUNCTION_FLAG;
+
+    if (m_is_generator) {
+        if (m_is_constructor_definition) {
+            // constructors must return the constructed object, so can't be generators
+            visitor->GetCompilationUnit()->GetErrorList().AddError(CompilerError(
+                LEVEL_ERROR,
+                Msg_yield_invalid_in_constructor,
+                m_location
+            ));
+        }
+
+        // calling a generator function returns the generator object,
+        // each resume of which produces the next yielded value.
+        m_return_type = BuiltinTypes::ANY;
+    } else if (function_scope->GetReturnTypes().Any()) {
         // search through return types for ambiguities
         for (const auto &it : function_scope->GetReturnTypes()) {
             AssertThrow(it.first != nullptr);
@@ -450,6 +467,10 @@ std::unique_ptr<Buildable> AstFunctionExpression::Build(AstVisitor *visitor, Mod
         flags |= FunctionFlags::CLOSURE;
     }
 
+    if (m_is_generator) {
+        flags |= FunctionFlags::GENERATOR;
+    }
+
     // the label to jump to the very end
     LabelId end_label = context_guard->NewLabel();
     chunk->TakeOwnershipOfLabel(end_label);
@@ -476,6 +497,7 @@ std::unique_ptr<Buildable> AstFunctionExpression::Build(AstVisitor *visitor, Mod
 
     auto func = BytecodeUtil::Make<BuildableFunction>();
     func->label_id = func_addr;
+    func->end_label_id = end_label;
     func->reg = rp;
     func->nargs = nargs;
     func->flags = flags;
@@ -536,9 +558,18 @@ std::unique_ptr<Buildable> AstFunctionExpression::BuildFunctionBody(AstVisitor *
     // increase stack size for call stack info
     visitor->GetCompilationUnit()->GetInstructionStream().IncStackSize();
 
+    // the function's frame starts just above the call stack info
+    const Int frame_base_stack_size_before = visitor->GetCompilationUnit()->GetInstructionStream().GetFrameBaseStackSize();
+    const Int frame_num_args_before = visitor->GetCompilationUnit()->GetInstructionStream().GetFrameNumArgs();
+    visitor->GetCompilationUnit()->GetInstructionStream().SetFrameBaseStackSize(visitor->GetCompilationUnit()->GetInstructionStream().GetStackSize());
+    visitor->GetCompilationUnit()->GetInstructionStream().SetFrameNumArgs(Int(param_stack_size));
+
     // build the function body
     chunk->Append(m_block_with_parameters->Build(visitor, mod));
 
+    visitor->GetCompilationUnit()->GetInstructionStream().SetFrameBaseStackSize(frame_base_stack_size_before);
+    visitor->GetCompilationUnit()->GetInstructionStream().SetFrameNumArgs(frame_num_args_before);
+
     if (!m_block_with_parameters->IsLastStatementReturn()) {
         // add RET instruction
         chunk->Append(BytecodeUtil::Make<Return>());
@@ -554,6 +585,77 @@ std::unique_ptr<Buildable> AstFunctionExpression::BuildFunctionBody(AstVisitor *
     return chunk;
 }
 
+RC<AstExpression> AstFunctionExpression::GetBodyExpression() const
+{
+    if (m_block_with_parameters == nullptr) {
+        return nullptr;
+    }
+
+    RC<AstExpression> body_expr;
+    SizeType num_statements = 0;
+
+    for (const RC<AstStatement> &stmt : m_block_with_parameters->GetChildren()) {
+        // the return type specification emits no code of its own
+        if (stmt == nullptr || stmt.Get() == m_return_type_specification.Get()) {
+            continue;
+        }
+
+        if (++num_statements > 1) {
+            return nullptr;
+        }
+
+        if (const AstReturnStatement *return_stmt = dynamic_cast<const AstReturnStatement *>(stmt.Get())) {
+            body_expr = return_stmt->GetExpression();
+        } else if (dynamic_cast<const AstExpression *>(stmt.Get())) {
+            body_expr = RC<AstStatement>(stmt).CastUnsafe<AstExpression>();
+        } else {
+            return nullptr;
+        }
+    }
+
+    return body_expr;
+}
+
+std::unique_ptr<Buildable> AstFunctionExpression::BuildInline(AstVisitor *visitor, Module *mod)
+{
+    RC<AstExpression> body_expr = GetBodyExpression();
+    AssertThrow(body_expr != nullptr);
+
+    // the pushed arguments take the place of the parameters
+    const Int stack_size = visitor->GetCompilationUnit()->GetInstructionStream().GetStackSize();
+    const Int args_start = stack_size - Int(m_parameters.Size());
+
+    Array<Int> previous_stack_locations;
+    previous_stack_locations.Reserve(m_parameters.Size());
+
+    for (SizeType index = 0; index < m_parameters.Size(); index++) {
+        AssertThrow(m_parameters[index] != nullptr);
+
+        const RC<Identifier> &identifier = m_parameters[index]->GetIdentifier();
+        AssertThrow(identifier != nullptr);
+
+        previous_stack_locations.PushBack(identifier->GetStackLocation());
+
+        identifier->ResetStackLocation();
+        identifier->SetStackLocation(args_start + Int(index));
+    }
+
+    std::unique_ptr<Buildable> buildable = body_expr->Build(visitor, mod);
+
+    // the function may still be built where it is declared
+    for (SizeType index = 0; index < m_parameters.Size(); index++) {
+        const RC<Identifier> &identifier = m_parameters[index]->GetIdentifier();
+
+        identifier->ResetStackLocation();
+
+        if (previous_stack_locations[index] != -1) {
+            identifier->SetStackLocation(previous_stack_locations[index]);
+        }
+    }
+
+    return buildable;
+}
+
 void AstFunctionExpression::Optimize(AstVisitor *visitor, Module *mod)
 {
     if (m_closure_type_expr != nullptr) {
@@ -33,6 +33,27 @@ public:
     void SetIsConstructorDefinition(bool is_constructor_definition)
         { m_is_constructor_definition = is_constructor_definition; }
 
+    Bool IsGenerator() const
+        { return m_is_generator; }
+
+    Bool IsClosure() const
+        { return m_is_closure; }
+
+    const Array<RC<AstParameter>> &GetParameters() const
+        { return m_parameters; }
+
+    /*! \brief The body as it was analyzed, with the return type specification prepended. Null before Visit(). */
+    const RC<AstBlock> &GetBlockWithParameters() const
+        { return m_block_with_parameters; }
+
+    /*! \brief Returns the expression the body consists of, if the body is a single
+        expression statement or a single return statement; otherwise null. */
+    RC<AstExpression> GetBodyExpression() const;
+
+    /*! \brief Build the body expression in place of a call to this function.
+        The arguments must already have been pushed to the stack. */
+    std::unique_ptr<Buildable> BuildInline(AstVisitor *visitor, Module *mod);
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
@@ -77,6 +98,7 @@ protected:
     RC<AstBlock>                    m_block_with_parameters;
 
     Bool                            m_is_constructor_definition;
+    Bool                            m_is_generator;
 
     SymbolTypePtr_t                 m_symbol_type;
     SymbolTypePtr_t                 m_return_type;
@@ -20,6 +20,15 @@ public:
     );
     virtual ~AstIfStatement() = default;
 
+    const RC<AstExpression> &GetConditional() const
+        { return m_conditional; }
+
+    const RC<AstBlock> &GetBlock() const
+        { return m_block; }
+
+    const RC<AstBlock> &GetElseBlock() const
+        { return m_else_block; }
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
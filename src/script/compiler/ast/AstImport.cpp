@@ -6,6 +6,7 @@
 #include <script/compiler/Lexer.hpp>
 #include <script/compiler/Parser.hpp>
 #include <script/compiler/SemanticAnalyzer.hpp>
+#include <script/compiler/ImportPreloader.hpp>
 
 #include <util/StringUtil.hpp>
 
@@ -22,6 +23,31 @@ AstImport::AstImport(const SourceLocation &location)
 {
 }
 
+// Removes and returns the preloaded parse of the file, if there is one. Each parse is only used once,
+// since analysis modifies the AST; a file imported again is parsed again, as before.
+static RC<PreloadedImport> TakePreloadedImport(
+    CompilationUnit *compilation_unit,
+    const String &canon_path,
+    const String &filepath
+)
+{
+    const auto it = compilation_unit->m_preloaded_imports.Find(canon_path);
+
+    if (it == compilation_unit->m_preloaded_imports.End()) {
+        return nullptr;
+    }
+
+    RC<PreloadedImport> preloaded = std::move(it->second);
+    compilation_unit->m_preloaded_imports.Erase(it);
+
+    // source locations of the parsed nodes carry the path it was read as
+    if (preloaded == nullptr || preloaded->filepath != filepath) {
+        return nullptr;
+    }
+
+    return preloaded;
+}
+
 void AstImport::CopyModules(
     AstVisitor *visitor,
     Module *mod_to_copy,
@@ -97,6 +123,16 @@ bool AstImport::TryOpenFile(const String &path, std::ifstream &is)
     return is.is_open();
 }
 
+String AstImport::GetCanonicalPath(const String &filepath)
+{
+    // parse path into vector
+    Array<String> path_parts = filepath.Split('\\', '/');
+    // canonicalize the vector
+    path_parts = StringUtil::CanonicalizePath(path_parts);
+    // put it back into a string
+    return String::Join(path_parts, '/');
+}
+
 void AstImport::PerformImport(
     AstVisitor *visitor,
     Module *mod,
@@ -116,12 +152,7 @@ void AstImport::PerformImport(
         return;
     }
 
-    // parse path into vector
-    Array<String> path_parts = filepath.Split('\\', '/');
-    // canonicalize the vector
-    path_parts = StringUtil::CanonicalizePath(path_parts);
-    // put it back into a string
-    const String canon_path = String::Join(path_parts, '/');
+    const String canon_path = GetCanonicalPath(filepath);
 
     // first, check if the file has already been imported somewhere in this compilation unit
     const auto it = visitor->GetCompilationUnit()->m_imported_modules.Find(canon_path);
@@ -137,6 +168,15 @@ void AstImport::PerformImport(
                 false
             );
         }
+    } else if (RC<PreloadedImport> preloaded = TakePreloadedImport(visitor->GetCompilationUnit(), canon_path, filepath)) {
+        // file was already read and parsed by the ImportPreloader
+        visitor->GetCompilationUnit()->m_source_hashes.Set(filepath, preloaded->content_hash);
+        visitor->GetCompilationUnit()->GetErrorList().Concatenate(preloaded->errors);
+
+        m_ast_iterator.Append(std::move(preloaded->ast_iterator));
+
+        SemanticAnalyzer semantic_analyzer(&m_ast_iterator, visitor->GetCompilationUnit());
+        semantic_analyzer.Analyze();
     } else {
         // file hasn't been imported, so open it
         std::ifstream file;
@@ -163,6 +203,8 @@ void AstImport::PerformImport(
 
             source_file.ReadIntoBuffer(temp);
 
+            visitor->GetCompilationUnit()->m_source_hashes.Set(filepath, temp.GetHashCode().Value());
+
             // use the lexer and parser on this file buffer
             TokenStream token_stream(TokenStreamInfo {
                 filepath
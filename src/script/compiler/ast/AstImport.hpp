@@ -26,6 +26,9 @@ public:
         std::ifstream &is
     );
 
+    /*! \brief Returns the path with `.` and `..` parts resolved, used to tell whether two imports refer to the same file. */
+    static String GetCanonicalPath(const String &filepath);
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override = 0;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
@@ -68,6 +68,11 @@ void AstMember::Visit(AstVisitor *visitor, Module *mod)
     SymbolTypePtr_t field_type = nullptr;
     SymbolTypeMember member;
 
+    // an instance holds the prototype members of its own type first, then those of each base,
+    // so a member found on a base is at an offset of the sizes of the prototypes before it.
+    // ~0u once any of them is not known statically.
+    UInt layout_offset = 0;
+
     for (UInt depth = 0; field_type == nullptr && m_target_type != nullptr; depth++) {
         AssertThrow(m_target_type != nullptr);
         m_target_type = m_target_type->GetUnaliased();
@@ -112,11 +117,10 @@ void AstMember::Visit(AstVisitor *visitor, Module *mod)
             UInt field_index = ~0u;
 
             if (m_target_type->FindPrototypeMember(m_field_name, member, field_index)) {
-                // only set m_found_index if found in first level.
-                // for members from base objects,
-                // we load based on hash.
-                if (depth == 0) {
-                    m_found_index = field_index;
+                // members of base objects are loaded by index into the flattened layout when it
+                // is known, otherwise we load based on hash.
+                if (layout_offset != ~0u && layout_offset + field_index < Config::max_data_members) {
+                    m_found_index = layout_offset + field_index;
                 }
 
                 field_type = member.type;
@@ -125,6 +129,14 @@ void AstMember::Visit(AstVisitor *visitor, Module *mod)
             }
         }
 
+        if (layout_offset != ~0u) {
+            const Int prototype_size = m_target_type->GetPrototypeSize();
+
+            layout_offset = prototype_size < 0
+                ? ~0u
+                : layout_offset + UInt(prototype_size);
+        }
+
         if (auto base = m_target_type->GetBaseType()) {
             m_target_type = base->GetUnaliased();
         } else {
@@ -16,6 +16,9 @@ public:
     );
     virtual ~AstMember() = default;
     
+    const String &GetFieldName() const
+        { return m_field_name; }
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
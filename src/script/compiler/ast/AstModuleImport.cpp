@@ -90,6 +90,50 @@ AstModuleImport::AstModuleImport(
 {
 }
 
+String AstModuleImport::GetCurrentDirectory() const
+{
+    // find the folder which the current file is in
+    const SizeType index = std::string(m_location.GetFileName().Data()).find_last_of("/\\");
+
+    String current_dir;
+    if (index != std::string::npos) {
+        current_dir = m_location.GetFileName().Substr(0, index);
+    }
+
+    return current_dir;
+}
+
+String AstModuleImport::FindModuleFile(
+    const String &name,
+    const FlatSet<String> &scan_paths,
+    Array<String> &out_tried_paths
+)
+{
+    std::ifstream file;
+
+    // iterate through library paths to try and find a file
+    for (const String &scan_path : scan_paths) {
+        const String ext = ".hypscript";
+
+        String found_path = String(FileSystem::Join(scan_path.Data(), (name + ext).Data()).c_str());
+        out_tried_paths.PushBack(found_path);
+
+        if (AstImport::TryOpenFile(found_path, file)) {
+            return found_path;
+        }
+
+        // try it without extension
+        found_path = String(FileSystem::Join(scan_path.Data(), name.Data()).c_str());
+        out_tried_paths.PushBack(found_path);
+
+        if (AstImport::TryOpenFile(found_path, file)) {
+            return found_path;
+        }
+    }
+
+    return String::empty;
+}
+
 void AstModuleImport::Visit(AstVisitor *visitor, Module *mod)
 {
     AssertThrow(!m_parts.Empty());
@@ -116,21 +160,10 @@ void AstModuleImport::Visit(AstVisitor *visitor, Module *mod)
     // we will allow duplicates in imports like `import range::{_Detail_}`
     // and we won't import the 'range' module again
     if (first->GetParts().Empty() || !opened) {
-        // find the folder which the current file is in
-        const SizeType index = std::string(m_location.GetFileName().Data()).find_last_of("/\\");
-
-        String current_dir;
-        if (index != std::string::npos) {
-            current_dir = m_location.GetFileName().Substr(0, index);
-        }
-
-        std::ifstream file;
-
         FlatSet<String> scan_paths;
-        String found_path;
 
         // add current directory as first.
-        scan_paths.Insert(current_dir);
+        scan_paths.Insert(GetCurrentDirectory());
 
         // add this module's scan paths.
         for (const auto &scan_path : mod->GetScanPaths()) {
@@ -145,30 +178,11 @@ void AstModuleImport::Visit(AstVisitor *visitor, Module *mod)
             scan_paths.Insert(scan_path);
         }
 
-        // iterate through library paths to try and find a file
-        for (const String &scan_path : scan_paths) {
-            const String &filename = first->GetLeft();
-            const String ext = ".hypscript";
-
-            found_path = String(FileSystem::Join(scan_path.Data(), (filename + ext).Data()).c_str());
-            tried_paths.PushBack(found_path);
-
-            if (AstImport::TryOpenFile(found_path, file)) {
-                opened = true;
-                break;
-            }
+        const String found_path = FindModuleFile(first->GetLeft(), scan_paths, tried_paths);
 
-            // try it without extension
-            found_path = String(FileSystem::Join(scan_path.Data(), filename.Data()).c_str());
-            tried_paths.PushBack(found_path);
-
-            if (AstImport::TryOpenFile(found_path, file)) {
-                opened = true;
-                break;
-            }
-        }
+        if (found_path.Any()) {
+            opened = true;
 
-        if (opened) {
             AstImport::PerformImport(
                 visitor,
                 mod,
@@ -3,6 +3,7 @@
 
 #include <script/compiler/ast/AstImport.hpp>
 #include <core/lib/String.hpp>
+#include <core/lib/FlatSet.hpp>
 
 #include <string>
 
@@ -80,6 +81,21 @@ public:
         const SourceLocation &location
     );
 
+    const Array<RC<AstModuleImportPart>> &GetParts() const
+        { return m_parts; }
+
+    /*! \brief The directory of the file this import is in, which is searched first. */
+    String GetCurrentDirectory() const;
+
+    /*! \brief Finds the file for the module \ref{name}, trying `<name>.hypscript` and then `<name>`
+        in each of \ref{scan_paths}. Each path tried is appended to \ref{out_tried_paths}.
+        Returns an empty string if no file could be opened. */
+    static String FindModuleFile(
+        const String &name,
+        const FlatSet<String> &scan_paths,
+        Array<String> &out_tried_paths
+    );
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     
     virtual RC<AstStatement> Clone() const override;
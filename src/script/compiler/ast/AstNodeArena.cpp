@@ -0,0 +1,144 @@
+#include <script/compiler/ast/AstNodeArena.hpp>
+
+#include <system/Debug.hpp>
+
+#include <cstdlib>
+#include <new>
+
+namespace hyperion::compiler {
+
+// stored in front of every allocation, so Delete() knows where the memory came from
+struct alignas(std::max_align_t) AstNodeArenaHeader
+{
+    AstNodeArena    *arena;
+};
+
+static constexpr SizeType header_size = sizeof(AstNodeArenaHeader);
+
+static SizeType AlignSize(SizeType size)
+{
+    return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}
+
+static thread_local AstNodeArena *g_current_arena = nullptr;
+
+AstNodeArena::Scope::Scope(AstNodeArena *arena)
+    : m_previous(g_current_arena)
+{
+    g_current_arena = arena;
+}
+
+AstNodeArena::Scope::~Scope()
+{
+    g_current_arena = m_previous;
+}
+
+AstNodeArena::AstNodeArena()
+    : m_cursor(nullptr),
+      m_remaining(0),
+      m_num_reserved_bytes(0),
+      m_num_references(1)
+{
+}
+
+AstNodeArena::~AstNodeArena()
+{
+    for (void *block : m_blocks) {
+        std::free(block);
+    }
+}
+
+AstNodeArena *AstNodeArena::GetCurrent()
+{
+    return g_current_arena;
+}
+
+void *AstNodeArena::New(SizeType size)
+{
+    const SizeType total_size = header_size + AlignSize(size);
+
+    AstNodeArena *arena = g_current_arena;
+    void *memory;
+
+    if (arena != nullptr) {
+        memory = arena->Allocate(total_size);
+        arena->m_num_references.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        memory = std::malloc(total_size);
+    }
+
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    new (memory) AstNodeArenaHeader { arena };
+
+    return static_cast<UByte *>(memory) + header_size;
+}
+
+void AstNodeArena::Delete(void *ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    AstNodeArenaHeader *header = reinterpret_cast<AstNodeArenaHeader *>(static_cast<UByte *>(ptr) - header_size);
+
+    if (header->arena == nullptr) {
+        std::free(header);
+
+        return;
+    }
+
+    header->arena->DropReference();
+}
+
+void AstNodeArena::Release()
+{
+    DropReference();
+}
+
+void *AstNodeArena::Allocate(SizeType size)
+{
+    // large allocations get a block of their own, so the current block is not wasted
+    if (size > block_size / 4) {
+        void *block = std::malloc(size);
+
+        if (block != nullptr) {
+            m_blocks.PushBack(block);
+            m_num_reserved_bytes += size;
+        }
+
+        return block;
+    }
+
+    if (size > m_remaining) {
+        void *block = std::malloc(block_size);
+
+        if (block == nullptr) {
+            return nullptr;
+        }
+
+        m_blocks.PushBack(block);
+        m_num_reserved_bytes += block_size;
+
+        m_cursor = static_cast<UByte *>(block);
+        m_remaining = block_size;
+    }
+
+    void *memory = m_cursor;
+
+    m_cursor += size;
+    m_remaining -= size;
+
+    return memory;
+}
+
+void AstNodeArena::DropReference()
+{
+    if (m_num_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+} // namespace hyperion::compiler
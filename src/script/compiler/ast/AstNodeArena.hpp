@@ -0,0 +1,79 @@
+#ifndef AST_NODE_ARENA_HPP
+#define AST_NODE_ARENA_HPP
+
+#include <core/lib/DynArray.hpp>
+
+#include <Types.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace hyperion::compiler {
+
+/*! \brief Bump allocator for AST nodes and identifiers, owned by a CompilationUnit.
+
+    Classes that allocate through AstNodeArena::New() are placed in the arena that is current on the
+    calling thread (see AstNodeArena::Scope), or on the heap if there is none. Destructors still run
+    when the last reference to a node is dropped, but the memory is not freed individually; the arena
+    releases all of its blocks at once, after its owner has called Release() and every node allocated
+    from it has been destroyed. Nodes that outlive the compilation (e.g. nodes referenced by a shared
+    type) therefore keep the arena alive rather than dangling.
+
+    An arena must only be allocated from by one thread at a time. Nodes may be destroyed on any thread. */
+class AstNodeArena
+{
+public:
+    static constexpr SizeType block_size = 64 * 1024;
+
+    /*! \brief Makes \ref{arena} the arena new nodes on the current thread are allocated from,
+        until the Scope is destroyed. */
+    class Scope
+    {
+    public:
+        Scope(AstNodeArena *arena);
+        Scope(const Scope &other) = delete;
+        Scope &operator=(const Scope &other) = delete;
+        ~Scope();
+
+    private:
+        AstNodeArena    *m_previous;
+    };
+
+    AstNodeArena();
+    AstNodeArena(const AstNodeArena &other) = delete;
+    AstNodeArena &operator=(const AstNodeArena &other) = delete;
+
+    /*! \brief Returns the arena that is current on the calling thread, or nullptr. */
+    static AstNodeArena *GetCurrent();
+
+    /*! \brief Allocates \ref{size} bytes from the current arena, or from the heap if there is none. */
+    static void *New(SizeType size);
+    /*! \brief Frees memory returned by New(). Arena memory is only released once the whole arena is. */
+    static void Delete(void *ptr);
+
+    /*! \brief Called by the owner when it no longer needs the arena. The arena is destroyed
+        once every node allocated from it has been destroyed as well. */
+    void Release();
+
+    /*! \brief Returns the total number of bytes reserved for blocks. */
+    SizeType GetNumReservedBytes() const
+        { return m_num_reserved_bytes; }
+
+private:
+    ~AstNodeArena();
+
+    void *Allocate(SizeType size);
+    void DropReference();
+
+    Array<void *>           m_blocks;
+    UByte                   *m_cursor;
+    SizeType                m_remaining;
+    SizeType                m_num_reserved_bytes;
+
+    // live nodes, plus one for the owner
+    std::atomic<SizeType>   m_num_references;
+};
+
+} // namespace hyperion::compiler
+
+#endif
@@ -1,4 +1,5 @@
 #include <script/compiler/ast/AstReturnStatement.hpp>
+#include <script/compiler/ast/AstCallExpression.hpp>
 #include <script/compiler/Optimizer.hpp>
 #include <script/compiler/AstVisitor.hpp>
 #include <script/compiler/Compiler.hpp>
@@ -31,6 +32,7 @@ void AstReturnStatement::Visit(AstVisitor *visitor, Module *mod)
     // transverse the scope tree to make sure we are in a function
     bool in_function = false;
     bool is_constructor = false;
+    bool in_try_block = false;
 
     TreeNode<Scope> *top = mod->m_scopes.TopNode();
 
@@ -45,6 +47,10 @@ void AstReturnStatement::Visit(AstVisitor *visitor, Module *mod)
             break;
         }
 
+        if (top->Get().GetScopeFlags() & TRY_BLOCK_FLAG) {
+            in_try_block = true;
+        }
+
         m_num_pops += top->Get().GetIdentifierTable().CountUsedVariables();
         top = top->m_parent;
     }
@@ -54,6 +60,13 @@ void AstReturnStatement::Visit(AstVisitor *visitor, Module *mod)
 
         if (m_expr != nullptr) {
             top->Get().AddReturnType(m_expr->GetExprType(), m_location);
+
+            // returning the result of a call directly, so the call can reuse this function's frame
+            if (!in_try_block && !is_constructor) {
+                if (AstCallExpression *call_expr = dynamic_cast<AstCallExpression *>(m_expr.Get())) {
+                    call_expr->SetIsTailCall(true);
+                }
+            }
         } else {
             top->Get().AddReturnType(BuiltinTypes::VOID_TYPE, m_location);
         }
@@ -6,6 +6,7 @@
 
 #include <script/SourceLocation.hpp>
 #include <script/compiler/emit/Buildable.hpp>
+#include <script/compiler/ast/AstNodeArena.hpp>
 
 #include <memory>
 #include <vector>
@@ -29,6 +30,13 @@ public:
     AstStatement(const SourceLocation &location);
     virtual ~AstStatement() = default;
 
+    /*! \brief Nodes are allocated from the current AstNodeArena, if any. */
+    static void *operator new(std::size_t size)
+        { return AstNodeArena::New(size); }
+
+    static void operator delete(void *ptr)
+        { AstNodeArena::Delete(ptr); }
+
     SourceLocation &GetLocation() { return m_location; }
     const SourceLocation &GetLocation() const { return m_location; }
 
@@ -23,6 +23,9 @@ AstTryCatch::AstTryCatch(const RC<AstBlock> &try_block,
 
 void AstTryCatch::Visit(AstVisitor *visitor, Module *mod)
 {
+    // calls within the try block must return to it, so they are never tail calls
+    m_try_block->SetScopeFlags(m_try_block->GetScopeFlags() | TRY_BLOCK_FLAG);
+
     // accept the try block
     m_try_block->Visit(visitor, mod);
     // accept the catch block
@@ -42,30 +45,29 @@ std::unique_ptr<Buildable> AstTryCatch::Build(AstVisitor *visitor, Module *mod)
     LabelId end_label = context_guard->NewLabel();
     chunk->TakeOwnershipOfLabel(end_label);
 
+    // the label marking the end of the try-block
+    LabelId try_end_label = context_guard->NewLabel();
+    chunk->TakeOwnershipOfLabel(try_end_label);
+
     // the label to jump to the catch-block
     LabelId catch_label = context_guard->NewLabel();
     chunk->TakeOwnershipOfLabel(catch_label);
 
-    { // send the instruction to enter the try-block
+    { // record the try-block in the exception table. no instructions are emitted,
+      // if an exception is thrown the stack is unwound to this depth before jumping to the catch-block.
+        const InstructionStream &instruction_stream = visitor->GetCompilationUnit()->GetInstructionStream();
+
         auto instr_begin_try = BytecodeUtil::Make<BuildableTryCatch>();
         instr_begin_try->catch_label_id = catch_label;
+        instr_begin_try->end_label_id = try_end_label;
+        instr_begin_try->stack_depth = UInt32(instruction_stream.GetStackSize() - instruction_stream.GetFrameBaseStackSize());
         chunk->Append(std::move(instr_begin_try));
     }
 
-    // try block increases stack size to hold the data about the catch block
-    visitor->GetCompilationUnit()->GetInstructionStream().IncStackSize();
-
     // build the try-block
     chunk->Append(m_try_block->Build(visitor, mod));
 
-    { // send the instruction to end the try-block
-        auto instr_end_try = BytecodeUtil::Make<RawOperation<>>();
-        instr_end_try->opcode = END_TRY;
-        chunk->Append(std::move(instr_end_try));
-    }
-    
-    // decrease stack size for the try block
-    visitor->GetCompilationUnit()->GetInstructionStream().DecStackSize();
+    chunk->Append(BytecodeUtil::Make<LabelMarker>(try_end_label));
 
     // jump to the end, as to not execute the catch-block
     chunk->Append(BytecodeUtil::Make<Jump>(Jump::JMP, end_label));
@@ -73,9 +75,6 @@ std::unique_ptr<Buildable> AstTryCatch::Build(AstVisitor *visitor, Module *mod)
     // set the label's position to where the catch-block would be
     chunk->Append(BytecodeUtil::Make<LabelMarker>(catch_label));
 
-    // exception was thrown, pop all local variables from the try-block
-    chunk->Append(Compiler::PopStack(visitor, m_try_block->NumLocals()));
-
     // build the catch-block
     chunk->Append(m_catch_block->Build(visitor, mod));
 
@@ -127,11 +127,11 @@ void AstTypeExpression::Visit(AstVisitor *visitor, Module *mod)
         );
         
         if (m_is_proxy_class) {
-            m_symbol_type->GetFlags() |= SYMBOL_TYPE_FLAGS_PROXY;
+            m_symbol_type->SetFlags(m_symbol_type->GetFlags() | SYMBOL_TYPE_FLAGS_PROXY);
         }
 
         if (m_is_uninstantiated_generic) {
-            m_symbol_type->GetFlags() |= SYMBOL_TYPE_FLAGS_UNINSTANTIATED_GENERIC;
+            m_symbol_type->SetFlags(m_symbol_type->GetFlags() | SYMBOL_TYPE_FLAGS_UNINSTANTIATED_GENERIC);
         }
 
         m_type_object.Reset(new AstTypeObject(
@@ -194,7 +194,7 @@ void AstTypeExpression::Visit(AstVisitor *visitor, Module *mod)
         }
 
         if (has_custom_proto) {
-            m_symbol_type->GetFlags() |= SYMBOL_TYPE_FLAGS_PROXY;
+            m_symbol_type->SetFlags(m_symbol_type->GetFlags() | SYMBOL_TYPE_FLAGS_PROXY);
         }
     }
 
@@ -30,6 +30,11 @@ void AstTypeRef::Visit(AstVisitor *visitor, Module *mod)
 {
     AssertThrow(m_symbol_type != nullptr);
 
+    // the type object is loaded from static memory, so the class declaration must be kept
+    if (Identifier *declaration = visitor->GetCompilationUnit()->GetTypeDeclaration(m_symbol_type->GetUnaliased())) {
+        visitor->GetCompilationUnit()->AddIdentifierUse(declaration);
+    }
+
     m_is_visited = true;
 }
 
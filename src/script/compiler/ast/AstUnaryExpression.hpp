@@ -18,6 +18,19 @@ public:
         const SourceLocation &location
     );
 
+    const RC<AstExpression> &GetOperand() const
+        { return m_target; }
+
+    const Operator *GetOperator() const
+        { return m_op; }
+
+    bool IsPostfixVersion() const
+        { return m_is_postfix_version; }
+
+    /*! \brief True if the operator has been applied at compile time, so the operand is the result. */
+    bool IsFolded() const
+        { return m_folded; }
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
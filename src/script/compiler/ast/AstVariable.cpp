@@ -147,6 +147,7 @@ void AstVariable::Visit(AstVisitor *visitor, Module *mod)
             if (!m_should_inline) {
 #endif
                 m_properties.GetIdentifier()->IncUseCount();
+                visitor->GetCompilationUnit()->AddIdentifierUse(m_properties.GetIdentifier().Get());
 
 #if HYP_SCRIPT_ENABLE_VARIABLE_INLINING
             }
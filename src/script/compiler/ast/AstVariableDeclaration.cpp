@@ -52,6 +52,20 @@ void AstVariableDeclaration::Visit(AstVisitor *visitor, Module *mod)
         mod->m_scopes.Open(Scope(SCOPE_TYPE_NORMAL, UNINSTANTIATED_GENERIC_FLAG));
     }
 
+    // uses of identifiers from the body of a top-level function or class are attributed to it,
+    // so it can be left out of the program when nothing that is always compiled reaches it.
+    m_is_cullable = Config::cull_unreachable_declarations
+        && mod->IsInGlobalScope()
+        && visitor->GetCompilationUnit()->GetDeclarationUses() == nullptr
+        && (m_flags & (IdentifierFlags::FLAG_FUNCTION | IdentifierFlags::FLAG_CLASS))
+        && !(m_flags & (IdentifierFlags::FLAG_NATIVE | IdentifierFlags::FLAG_GENERIC));
+
+    Array<Identifier *> declaration_uses;
+
+    if (m_is_cullable) {
+        visitor->GetCompilationUnit()->SetDeclarationUses(&declaration_uses);
+    }
+
     if (m_proto != nullptr) {
         m_proto->Visit(visitor, mod);
     }
@@ -257,6 +271,10 @@ void AstVariableDeclaration::Visit(AstVisitor *visitor, Module *mod)
         }
     }
 
+    if (m_is_cullable) {
+        visitor->GetCompilationUnit()->SetDeclarationUses(nullptr);
+    }
+
     if (IsGeneric()) {
         // close template param scope
         mod->m_scopes.Close();
@@ -289,6 +307,7 @@ void AstVariableDeclaration::Visit(AstVisitor *visitor, Module *mod)
     if (m_identifier != nullptr) {
         m_identifier->GetFlags() |= m_flags;
         m_identifier->SetSymbolType(m_symbol_type);
+        m_identifier->SetNativeFunctionIndex(m_native_function_index);
 
         // set current value to be the assignment
         if (!m_identifier->GetCurrentValue()) {
@@ -296,6 +315,29 @@ void AstVariableDeclaration::Visit(AstVisitor *visitor, Module *mod)
             // because we need to use GetExprType(), which requires that the node has been visited.
             m_identifier->SetCurrentValue(m_real_assignment);
         }
+
+        if (m_is_cullable) {
+            for (Identifier *used : declaration_uses) {
+                used->AddUser(m_identifier.Get());
+            }
+
+            if (m_flags & IdentifierFlags::FLAG_CLASS) {
+                if (SymbolTypePtr_t held_type = m_real_assignment->GetHeldType()) {
+                    held_type = held_type->GetUnaliased();
+
+                    if (held_type->GetId() != -1) {
+                        visitor->GetCompilationUnit()->SetTypeDeclaration(held_type, m_identifier.Get());
+                    }
+                }
+            }
+        }
+    } else if (m_is_cullable) {
+        // could not declare; keep whatever it uses
+        for (Identifier *used : declaration_uses) {
+            used->AddUser(nullptr);
+        }
+
+        m_is_cullable = false;
     }
 }
 
@@ -305,6 +347,13 @@ std::unique_ptr<Buildable> AstVariableDeclaration::Build(AstVisitor *visitor, Mo
 
     AssertThrow(m_real_assignment != nullptr);
 
+    if (m_is_cullable && !m_identifier->IsReachable()) {
+        // only used by declarations that are themselves never reached
+        chunk->Append(BytecodeUtil::Make<Comment>(" Unreachable `" + m_name + "` culled"));
+
+        return chunk;
+    }
+
     if (!Config::cull_unused_objects || m_identifier->GetUseCount() > 0 || (m_flags & IdentifierFlags::FLAG_NATIVE)) {
         // update identifier stack location to be current stack size.
         m_identifier->SetStackLocation(visitor->GetCompilationUnit()->GetInstructionStream().GetStackSize());
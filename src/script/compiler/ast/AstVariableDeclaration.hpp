@@ -60,6 +60,14 @@ public:
         }
     }
 
+    /*! \brief For globals bound by the scripting API: the index of the native function in the
+        VM's native function table, given to the identifier when it is declared. */
+    Int GetNativeFunctionIndex() const
+        { return m_native_function_index; }
+
+    void SetNativeFunctionIndex(Int native_function_index)
+        { m_native_function_index = native_function_index; }
+
     virtual void Visit(AstVisitor *visitor, Module *mod) override;
     virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
     virtual void Optimize(AstVisitor *visitor, Module *mod) override;
@@ -84,12 +92,16 @@ protected:
     RC<AstPrototypeSpecification>   m_proto;
     RC<AstExpression>               m_assignment;
     IdentifierFlagBits              m_flags;
+    Int                             m_native_function_index = -1;
 
     // set while analyzing
     RC<AstExpression>               m_real_assignment;
 
     SymbolTypePtr_t                 m_symbol_type;
 
+    // top-level function or class, not built if nothing reachable uses it
+    bool                            m_is_cullable = false;
+
     RC<AstVariableDeclaration> CloneImpl() const
     {
         return RC<AstVariableDeclaration>(new AstVariableDeclaration(
@@ -0,0 +1,87 @@
+#include <script/compiler/ast/AstYieldStatement.hpp>
+#include <script/compiler/AstVisitor.hpp>
+#include <script/compiler/Module.hpp>
+
+#include <script/compiler/emit/BytecodeChunk.hpp>
+#include <script/compiler/emit/BytecodeUtil.hpp>
+
+#include <script/Instructions.hpp>
+#include <system/Debug.hpp>
+
+namespace hyperion::compiler {
+
+AstYieldStatement::AstYieldStatement(
+    const RC<AstExpression> &expr,
+    const SourceLocation &location
+) : AstStatement(location),
+    m_expr(expr)
+{
+}
+
+void AstYieldStatement::Visit(AstVisitor *visitor, Module *mod)
+{
+    if (m_expr != nullptr) {
+        m_expr->Visit(visitor, mod);
+    }
+
+    // transverse the scope tree to find the enclosing function
+    TreeNode<Scope> *top = mod->m_scopes.TopNode();
+
+    while (top != nullptr) {
+        if (top->Get().GetScopeType() == SCOPE_TYPE_FUNCTION) {
+            break;
+        }
+
+        top = top->m_parent;
+    }
+
+    if (top != nullptr) {
+        // mark the function as a generator; it is picked up once the body has been visited
+        top->Get().SetScopeFlags(top->Get().GetScopeFlags() | GENERATOR_FUNCTION_FLAG);
+    } else {
+        // error; 'yield' not allowed outside of a function
+        visitor->GetCompilationUnit()->GetErrorList().AddError(CompilerError(
+            LEVEL_ERROR,
+            Msg_yield_outside_function,
+            m_location
+        ));
+    }
+}
+
+std::unique_ptr<Buildable> AstYieldStatement::Build(AstVisitor *visitor, Module *mod)
+{
+    std::unique_ptr<BytecodeChunk> chunk = BytecodeUtil::Make<BytecodeChunk>();
+
+    // get active register
+    UInt8 rp = visitor->GetCompilationUnit()->GetInstructionStream().GetCurrentRegister();
+
+    if (m_expr != nullptr) {
+        chunk->Append(m_expr->Build(visitor, mod));
+
+        rp = visitor->GetCompilationUnit()->GetInstructionStream().GetCurrentRegister();
+    } else {
+        chunk->Append(BytecodeUtil::Make<ConstNull>(rp));
+    }
+
+    // the whole frame is saved by the VM, so locals are left on the stack
+    auto instr_yield = BytecodeUtil::Make<RawOperation<>>();
+    instr_yield->opcode = YIELD;
+    instr_yield->Accept<UInt8>(rp);
+    chunk->Append(std::move(instr_yield));
+
+    return chunk;
+}
+
+void AstYieldStatement::Optimize(AstVisitor *visitor, Module *mod)
+{
+    if (m_expr != nullptr) {
+        m_expr->Optimize(visitor, mod);
+    }
+}
+
+RC<AstStatement> AstYieldStatement::Clone() const
+{
+    return CloneImpl();
+}
+
+} // namespace hyperion::compiler
@@ -0,0 +1,52 @@
+#ifndef AST_YIELD_STATEMENT_HPP
+#define AST_YIELD_STATEMENT_HPP
+
+#include <script/compiler/ast/AstStatement.hpp>
+#include <script/compiler/ast/AstExpression.hpp>
+
+namespace hyperion::compiler {
+
+/*! \brief Suspends the enclosing function, handing the value of the expression
+    back to whoever resumed it. A function containing 'yield' is compiled as a generator. */
+class AstYieldStatement final : public AstStatement
+{
+public:
+    AstYieldStatement(
+        const RC<AstExpression> &expr,
+        const SourceLocation &location
+    );
+    virtual ~AstYieldStatement() = default;
+
+    const RC<AstExpression> &GetExpression() const
+        { return m_expr; }
+
+    virtual void Visit(AstVisitor *visitor, Module *mod) override;
+    virtual std::unique_ptr<Buildable> Build(AstVisitor *visitor, Module *mod) override;
+    virtual void Optimize(AstVisitor *visitor, Module *mod) override;
+    
+    virtual RC<AstStatement> Clone() const override;
+
+    virtual HashCode GetHashCode() const override
+    {
+        HashCode hc;
+        hc.Add(TypeName<AstYieldStatement>());
+        hc.Add(m_expr ? m_expr->GetHashCode() : HashCode());
+
+        return hc;
+    }
+
+private:
+    RC<AstExpression>   m_expr;
+
+    RC<AstYieldStatement> CloneImpl() const
+    {
+        return RC<AstYieldStatement>(new AstYieldStatement(
+            CloneAstNode(m_expr),
+            m_location
+        ));
+    }
+};
+
+} // namespace hyperion::compiler
+
+#endif
@@ -135,6 +135,15 @@ Builtins::Builtins(CompilationUnit *unit)
     )));
 }
 
+Builtins::~Builtins()
+{
+    for (SavedBuiltinType &saved : m_saved_types) {
+        saved.type->SetMembers(saved.members);
+        saved.type->SetTypeObject(Weak<AstTypeObject>());
+        saved.type->SetId(-1);
+    }
+}
+
 void Builtins::Visit(AstVisitor *visitor)
 {
     Array<SymbolTypePtr_t> builtin_types {
@@ -158,6 +167,8 @@ void Builtins::Visit(AstVisitor *visitor)
         AssertThrow(type_ptr->GetId() == -1);
         AssertThrow(type_ptr->GetTypeObject() == nullptr);
 
+        m_saved_types.PushBack(SavedBuiltinType { type_ptr, type_ptr->GetMembers() });
+
         // add 'name' member here
         type_ptr->AddMember({
             "name",
@@ -5,6 +5,7 @@
 #include <script/compiler/AstIterator.hpp>
 #include <script/compiler/ast/AstVariableDeclaration.hpp>
 #include <script/compiler/emit/BytecodeChunk.hpp>
+#include <script/compiler/type-system/SymbolType.hpp>
 
 #include <core/lib/HashMap.hpp>
 #include <core/lib/String.hpp>
@@ -22,6 +23,9 @@ class Builtins
 {
 public:
     Builtins(CompilationUnit *unit);
+    Builtins(const Builtins &other) = delete;
+    Builtins &operator=(const Builtins &other) = delete;
+    ~Builtins();
 
     RC<AstVariableDeclaration> FindVariable(const String &name) const
     {
@@ -42,14 +46,25 @@ public:
     }
 
     /** This will analyze the builtins, and add them to the syntax tree.
+        The builtin types are shared by every compilation, so what is
+        registered on them here is undone when the Builtins are destroyed,
+        allowing the next compilation to register them again.
      */
     void Visit(AstVisitor *visitor);
 
 private:
+    struct SavedBuiltinType
+    {
+        SymbolTypePtr_t         type;
+        Array<SymbolTypeMember> members;
+    };
+
     static const SourceLocation BUILTIN_SOURCE_LOCATION;
 
     CompilationUnit                     *m_unit;
     Array<RC<AstVariableDeclaration>>   m_vars;
+    // state of the builtin types from before they were registered by Visit()
+    Array<SavedBuiltinType>             m_saved_types;
 };
 
 } // namespace hyperion::compiler
@@ -482,6 +482,29 @@ void DecompilationUnit::DecodeNext(
 
         break;
     }
+    case LOAD_ARRAYIDX_UNCHECKED:
+    {
+        UInt8 reg;
+        bs.Read(&reg);
+
+        UInt8 src;
+        bs.Read(&src);
+
+        UInt8 idx;
+        bs.Read(&idx);
+
+        if (os != nullptr) {
+            (*os)
+                << "load_arrayidx_unchecked ["
+                    << "%" << (int)reg << ", "
+                    << "%" << (int)src << ", "
+                    << "%" << (int)idx << ""
+                << "]"
+                << std::endl;
+        }
+
+        break;
+    }
     case LOAD_OFFSET_REF:
     {
         UInt8 reg;
@@ -752,6 +775,29 @@ void DecompilationUnit::DecodeNext(
 
         break;
     }
+    case MOV_ARRAYIDX_UNCHECKED:
+    {
+        UInt8 reg;
+        bs.Read(&reg);
+
+        UInt8 idx;
+        bs.Read(&idx);
+
+        UInt8 src;
+        bs.Read(&src);
+
+        if (os != nullptr) {
+            (*os)
+                << "mov_arrayidx_unchecked ["
+                    << "%" << (int)reg << ", "
+                    << "%" << (int)idx << ", "
+                    << "%" << (int)src << ""
+                << "]"
+                << std::endl;
+        }
+
+        break;
+    }
     case MOV_REG:
     {
         UInt8 dst;
@@ -962,35 +1008,58 @@ void DecompilationUnit::DecodeNext(
 
         break;
     }
-    case RET:
+    case TAIL_CALL:
     {
+        UInt8 func;
+        bs.Read(&func);
+
+        UInt8 argc;
+        bs.Read(&argc);
+
+        UInt8 frame_argc;
+        bs.Read(&frame_argc);
+
+        UInt16 frame_locals;
+        bs.Read(&frame_locals);
+
         if (os != nullptr) {
             (*os)
-                << "ret"
+                << "tail_call ["
+                    << "%" << (int)func << ", "
+                    << "u8(" << (int)argc << "), "
+                    << "u8(" << (int)frame_argc << "), "
+                    << "u16(" << (int)frame_locals << ")"
+                << "]"
                 << std::endl;
         }
 
         break;
     }
-    case BEGIN_TRY:
+    case CALL_NATIVE:
     {
-        UInt32 addr;
-        bs.Read(&addr);
+        UInt16 index;
+        bs.Read(&index);
+
+        UInt8 argc;
+        bs.Read(&argc);
 
         if (os != nullptr) {
             (*os)
-                << "begin_try ["
-                    << "@(" << std::hex << addr << std::dec << ")"
+                << "call_native ["
+                    << "u16(" << (int)index << "), "
+                    << "u8(" << (int)argc << ")"
                 << "]"
                 << std::endl;
         }
 
         break;
     }
-    case END_TRY:
+    case RET:
     {
         if (os != nullptr) {
-            (*os) << "end_try" << std::endl;
+            (*os)
+                << "ret"
+                << std::endl;
         }
 
         break;
@@ -1611,6 +1680,21 @@ void DecompilationUnit::DecodeNext(
 
         break;
     }
+    case YIELD:
+    {
+        UInt8 reg;
+        bs.Read(&reg);
+
+        if (os != nullptr) {
+            (*os)
+                << "yield ["
+                    << "%" << (int)reg
+                << "]"
+                << std::endl;
+        }
+
+        break;
+    }
     case EXIT:
     {
         if (os != nullptr) {
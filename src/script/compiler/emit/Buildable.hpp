@@ -2,7 +2,6 @@
 #define BUILDABLE_HPP
 
 #include <core/lib/DynArray.hpp>
-#include <core/lib/SortedArray.hpp>
 #include <core/Name.hpp>
 #include <Types.hpp>
 
@@ -36,7 +35,9 @@ struct BuildParams
 {
     SizeType                block_offset = 0;
     SizeType                local_offset = 0;
-    SortedArray<LabelInfo>  labels;
+    /*! \brief Position of each label in the baked stream, indexed by label id.
+        Label ids are allocated sequentially, so the table stays dense. */
+    Array<LabelPosition>    labels;
 };
 
 struct Buildable
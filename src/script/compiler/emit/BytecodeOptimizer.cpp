@@ -0,0 +1,725 @@
+#include <script/compiler/emit/BytecodeOptimizer.hpp>
+#include <script/compiler/emit/StorageOperation.hpp>
+#include <script/compiler/emit/BytecodeUtil.hpp>
+
+#include <math/MathUtil.hpp>
+
+#include <core/lib/CMemory.hpp>
+#include <core/lib/HashMap.hpp>
+
+#include <system/Debug.hpp>
+
+namespace hyperion::compiler {
+
+// registers above this index are never emitted by the compiler; instructions using them are treated as barriers
+static constexpr UInt num_tracked_registers = 32;
+static constexpr UInt32 all_registers_mask = ~0u;
+
+/*! \brief What a register is known to hold at some point in the instruction list.
+    Stack slots are relative to the stack pointer the last time everything was forgotten. */
+struct BytecodeOptimizerRegisterState
+{
+    enum ConstantType : UInt8
+    {
+        CONSTANT_NONE,
+        CONSTANT_I32,
+        CONSTANT_I64,
+        CONSTANT_U32,
+        CONSTANT_U64,
+        CONSTANT_F32,
+        CONSTANT_F64,
+        CONSTANT_BOOL,
+        CONSTANT_NULL
+    };
+
+    Bool            has_slot = false;
+    Int             slot = 0;
+    Int             stack_index = -1;
+    Int             static_index = -1;
+    ConstantType    constant_type = CONSTANT_NONE;
+    UInt64          constant_bits = 0;
+
+    Bool IsKnown() const
+        { return has_slot || stack_index != -1 || static_index != -1 || constant_type != CONSTANT_NONE; }
+
+    void ForgetMemory()
+    {
+        has_slot = false;
+        stack_index = -1;
+        static_index = -1;
+    }
+
+    Bool HoldsSameValueAs(const BytecodeOptimizerRegisterState &other) const
+    {
+        return (has_slot && other.has_slot && slot == other.slot)
+            || (stack_index != -1 && stack_index == other.stack_index)
+            || (static_index != -1 && static_index == other.static_index)
+            || (constant_type != CONSTANT_NONE && constant_type == other.constant_type && constant_bits == other.constant_bits);
+    }
+
+    /*! \brief Keep only what is also known by \ref other, where two paths join. */
+    void Meet(const BytecodeOptimizerRegisterState &other)
+    {
+        if (!(has_slot && other.has_slot && slot == other.slot)) {
+            has_slot = false;
+        }
+
+        if (stack_index != other.stack_index) {
+            stack_index = -1;
+        }
+
+        if (static_index != other.static_index) {
+            static_index = -1;
+        }
+
+        if (constant_type != other.constant_type || constant_bits != other.constant_bits) {
+            constant_type = CONSTANT_NONE;
+        }
+    }
+
+    template <class T>
+    static BytecodeOptimizerRegisterState Constant(ConstantType type, T value)
+    {
+        static_assert(sizeof(T) <= sizeof(UInt64));
+
+        BytecodeOptimizerRegisterState state;
+        state.constant_type = type;
+        Memory::MemCpy(&state.constant_bits, &value, sizeof(T));
+
+        return state;
+    }
+};
+
+/*! \brief What is known at the jumps to a label that has not been reached yet. */
+struct BytecodeOptimizerJoinState
+{
+    BytecodeOptimizerRegisterState  registers[num_tracked_registers];
+    Int                             sp = 0;
+    // slots are only comparable between states with the same stack base
+    UInt                            stack_base = 0;
+    UInt32                          num_jumps = 0;
+};
+
+/*! \brief The registers an instruction reads and writes.
+    A pure instruction has no effect other than writing its registers, so it may be removed
+    when nothing reads the value it writes. */
+struct BytecodeOptimizerEffect
+{
+    Bool    is_barrier = false;
+    Bool    is_pure = false;
+    UInt32  reads = 0;
+    UInt32  writes = 0;
+};
+
+template <class T>
+static T ReadOperand(const RawOperation<> *operation, SizeType offset)
+{
+    AssertThrow(offset + sizeof(T) <= operation->data.Size());
+
+    T value;
+    Memory::MemCpy(&value, operation->data.Data() + offset, sizeof(T));
+
+    return value;
+}
+
+static BytecodeOptimizerEffect GetEffect(Buildable *buildable)
+{
+    BytecodeOptimizerEffect effect;
+
+    const auto Reg = [&effect](RegIndex reg) -> UInt32
+    {
+        if (reg >= num_tracked_registers) {
+            effect.is_barrier = true;
+
+            return 0;
+        }
+
+        return 1u << reg;
+    };
+
+    if (dynamic_cast<LabelMarker *>(buildable) || dynamic_cast<Comment *>(buildable)) {
+        return effect;
+    }
+
+    if (auto *comparison = dynamic_cast<Comparison *>(buildable)) {
+        effect.reads = Reg(comparison->reg_lhs);
+
+        if (comparison->comparison_class == Comparison::CMP) {
+            effect.reads |= Reg(comparison->reg_rhs);
+        }
+    } else if (auto *constant = dynamic_cast<ConstI32 *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstI64 *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstU32 *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstU64 *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstF32 *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstF64 *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstBool *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *constant = dynamic_cast<ConstNull *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(constant->reg);
+    } else if (auto *string = dynamic_cast<BuildableString *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(string->reg);
+    } else if (auto *function = dynamic_cast<BuildableFunction *>(buildable)) {
+        effect.is_pure = true;
+        effect.writes = Reg(function->reg);
+    } else if (auto *cast = dynamic_cast<CastOperation *>(buildable)) {
+        // cast_dynamic reads the type from the destination register
+        effect.reads = Reg(cast->reg_src) | Reg(cast->reg_dst);
+        effect.writes = Reg(cast->reg_dst);
+    } else if (auto *storage = dynamic_cast<StorageOperation *>(buildable)) {
+        if (storage->op.is_ref) {
+            effect.is_barrier = true;
+        } else if (storage->method == Methods::LOCAL || storage->method == Methods::STATIC) {
+            if (storage->operation == Operations::LOAD) {
+                effect.is_pure = true;
+                effect.writes = Reg(storage->op.a.reg);
+            } else {
+                effect.reads = Reg(storage->op.a.reg);
+            }
+        } else if (storage->method == Methods::MEMBER) {
+            if (storage->operation == Operations::LOAD) {
+                effect.reads = Reg(storage->op.b.object_data.reg);
+                effect.writes = Reg(storage->op.a.reg);
+            } else {
+                effect.reads = Reg(storage->op.b.object_data.reg) | Reg(storage->op.a.reg);
+            }
+        } else {
+            effect.is_barrier = true;
+        }
+    } else if (auto *operation = dynamic_cast<RawOperation<> *>(buildable)) {
+        switch (operation->opcode) {
+        case PUSH:
+            effect.reads = Reg(ReadOperand<RegIndex>(operation, 0));
+
+            break;
+        case POP: // fallthrough
+        case ADD_SP: // fallthrough
+        case SUB_SP:
+            break;
+        case LOAD_OFFSET:
+            effect.is_pure = true;
+            effect.writes = Reg(ReadOperand<RegIndex>(operation, 0));
+
+            break;
+        case MOV_REG:
+            effect.is_pure = true;
+            effect.writes = Reg(ReadOperand<RegIndex>(operation, 0));
+            effect.reads = Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex)));
+
+            break;
+        case ADD: // fallthrough
+        case SUB: // fallthrough
+        case MUL: // fallthrough
+        case DIV: // fallthrough
+        case MOD: // fallthrough
+        case AND: // fallthrough
+        case OR:  // fallthrough
+        case XOR: // fallthrough
+        case SHL: // fallthrough
+        case SHR:
+            effect.reads = Reg(ReadOperand<RegIndex>(operation, 0))
+                | Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex)));
+            effect.writes = Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex) * 2));
+
+            break;
+        case LOAD_ARRAYIDX_UNCHECKED:
+            effect.reads = Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex)))
+                | Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex) * 2));
+            effect.writes = Reg(ReadOperand<RegIndex>(operation, 0));
+
+            break;
+        case MOV_ARRAYIDX_UNCHECKED:
+            // only writes to the array, which is not tracked
+            effect.reads = Reg(ReadOperand<RegIndex>(operation, 0))
+                | Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex)))
+                | Reg(ReadOperand<RegIndex>(operation, sizeof(RegIndex) * 2));
+
+            break;
+        case NEG: // fallthrough
+        case NOT:
+            effect.reads = Reg(ReadOperand<RegIndex>(operation, 0));
+            effect.writes = effect.reads;
+
+            break;
+        default:
+            effect.is_barrier = true;
+
+            break;
+        }
+    } else {
+        // jumps, calls, returns, try blocks, types, exports...
+        effect.is_barrier = true;
+    }
+
+    return effect;
+}
+
+void BytecodeOptimizer::Optimize(BytecodeChunk *chunk)
+{
+    AssertThrow(chunk != nullptr);
+
+    m_instructions.Clear();
+
+    Flatten(chunk);
+    FindLabelUses();
+
+    const Array<Range> ranges = Split(BytecodeUtil::GetNumCodegenWorkers(m_instructions.Size()));
+
+    Array<SizeType> num_removed;
+    num_removed.Resize(ranges.Size());
+
+    // instructions are only ever removed by the worker whose range they are in
+    BytecodeUtil::RunWorkers(UInt(ranges.Size()), [this, &ranges, &num_removed](UInt worker_index)
+    {
+        const Range &range = ranges[worker_index];
+
+        num_removed[worker_index] = ForwardPass(range) + BackwardPass(range);
+    });
+
+    for (const SizeType count : num_removed) {
+        m_num_removed += count;
+    }
+
+    Compact(chunk);
+
+    m_instructions.Clear();
+    m_label_uses.Clear();
+}
+
+void BytecodeOptimizer::Flatten(BytecodeChunk *chunk)
+{
+    for (SizeType index = 0; index < chunk->buildables.Size(); index++) {
+        if (auto *nested = dynamic_cast<BytecodeChunk *>(chunk->buildables[index].get())) {
+            Flatten(nested);
+
+            continue;
+        }
+
+        m_instructions.PushBack(InstructionRef { chunk, index });
+    }
+}
+
+void BytecodeOptimizer::FindLabelUses()
+{
+    m_label_uses.Clear();
+
+    const auto Use = [this](LabelId label_id) -> LabelUse &
+    {
+        if (m_label_uses.Size() <= label_id) {
+            m_label_uses.Resize(label_id + 1);
+        }
+
+        return m_label_uses[label_id];
+    };
+
+    for (const InstructionRef &ref : m_instructions) {
+        Buildable *buildable = ref.Get();
+
+        if (auto *jump = dynamic_cast<Jump *>(buildable)) {
+            Use(jump->label_id).num_jumps++;
+        } else if (auto *function = dynamic_cast<BuildableFunction *>(buildable)) {
+            Use(function->label_id).is_entry = true;
+            Use(function->end_label_id).is_entry = true;
+        } else if (auto *try_catch = dynamic_cast<BuildableTryCatch *>(buildable)) {
+            Use(try_catch->catch_label_id).is_entry = true;
+            Use(try_catch->end_label_id).is_entry = true;
+        }
+    }
+}
+
+auto BytecodeOptimizer::Split(UInt max_ranges) const -> Array<Range>
+{
+    Array<Range> ranges;
+
+    const SizeType target_size = m_instructions.Size() / MathUtil::Max(max_ranges, 1u);
+    SizeType begin = 0;
+
+    for (SizeType index = target_size; index < m_instructions.Size() && ranges.Size() + 1 < max_ranges; index++) {
+        if (!dynamic_cast<LabelMarker *>(m_instructions[index].Get()) || !dynamic_cast<Jump *>(m_instructions[index - 1].Get())) {
+            continue;
+        }
+
+        // the forward pass forgets everything at the label, and the backward pass at the jump
+        ranges.PushBack(Range { begin, index });
+
+        begin = index;
+        index = MathUtil::Max(index, begin + target_size - 1);
+    }
+
+    ranges.PushBack(Range { begin, m_instructions.Size() });
+
+    return ranges;
+}
+
+SizeType BytecodeOptimizer::ForwardPass(const Range &range)
+{
+    using RegisterState = BytecodeOptimizerRegisterState;
+
+    RegisterState registers[num_tracked_registers];
+    Int sp = 0;
+    UInt stack_base = 0;
+
+    // false after an unconditional jump, until the next label
+    Bool is_reachable = true;
+
+    // what is known at the jumps to labels further ahead
+    HashMap<LabelId, BytecodeOptimizerJoinState> join_states;
+
+    SizeType num_removed = 0;
+
+    const auto Reset = [&registers, &sp, &stack_base]()
+    {
+        for (RegisterState &state : registers) {
+            state = { };
+        }
+
+        sp = 0;
+        ++stack_base;
+    };
+
+    // keep only what is known on both paths
+    const auto Join = [&registers, &sp, &stack_base](const BytecodeOptimizerJoinState &join_state)
+    {
+        const Bool is_same_stack = join_state.stack_base == stack_base && join_state.sp == sp;
+
+        for (UInt reg = 0; reg < num_tracked_registers; reg++) {
+            registers[reg].Meet(join_state.registers[reg]);
+
+            if (!is_same_stack) {
+                registers[reg].has_slot = false;
+            }
+        }
+
+        if (!is_same_stack) {
+            sp = 0;
+            ++stack_base;
+        }
+    };
+
+    const auto ForgetMemory = [&registers]()
+    {
+        for (RegisterState &state : registers) {
+            state.ForgetMemory();
+        }
+    };
+
+    // the stack shrunk to `new_sp`: slots above it are gone, and absolute stack indices may now name other values
+    const auto ShrinkStack = [&registers, &sp](Int new_sp)
+    {
+        for (RegisterState &state : registers) {
+            if (state.has_slot && state.slot >= new_sp) {
+                state.has_slot = false;
+            }
+
+            state.stack_index = -1;
+        }
+
+        sp = new_sp;
+    };
+
+    // returns true if `reg` already holds `loaded`, in which case the load is redundant
+    const auto Load = [&registers](RegIndex reg, RegisterState loaded) -> Bool
+    {
+        if (registers[reg].HoldsSameValueAs(loaded)) {
+            return true;
+        }
+
+        // another register may already hold the value, with more known about it
+        for (const RegisterState &state : registers) {
+            if (state.HoldsSameValueAs(loaded)) {
+                loaded = state;
+
+                break;
+            }
+        }
+
+        registers[reg] = loaded;
+
+        return false;
+    };
+
+    for (SizeType index = range.begin; index < range.end; index++) {
+        const InstructionRef &ref = m_instructions[index];
+        Buildable *buildable = ref.Get();
+
+        if (auto *label = dynamic_cast<LabelMarker *>(buildable)) {
+            const LabelUse use = GetLabelUse(label->id);
+            const auto it = join_states.Find(label->id);
+
+            if (use.is_entry || (use.num_jumps != 0 && (it == join_states.End() || it->second.num_jumps != use.num_jumps))) {
+                // entered from somewhere we have not seen yet (a backward jump, another range, or not by a jump at all)
+                Reset();
+            } else if (it == join_states.End()) {
+                if (!is_reachable) {
+                    Reset();
+                }
+            } else if (!is_reachable) {
+                for (UInt reg = 0; reg < num_tracked_registers; reg++) {
+                    registers[reg] = it->second.registers[reg];
+                }
+
+                sp = it->second.sp;
+                stack_base = it->second.stack_base;
+            } else {
+                Join(it->second);
+            }
+
+            if (it != join_states.End()) {
+                join_states.Erase(it);
+            }
+
+            is_reachable = true;
+
+            continue;
+        }
+
+        if (auto *jump = dynamic_cast<Jump *>(buildable)) {
+            const LabelUse use = GetLabelUse(jump->label_id);
+
+            if (!use.is_entry && is_reachable) {
+                auto it = join_states.Find(jump->label_id);
+
+                if (it == join_states.End()) {
+                    BytecodeOptimizerJoinState join_state;
+
+                    for (UInt reg = 0; reg < num_tracked_registers; reg++) {
+                        join_state.registers[reg] = registers[reg];
+                    }
+
+                    join_state.sp = sp;
+                    join_state.stack_base = stack_base;
+
+                    it = join_states.Insert(jump->label_id, std::move(join_state)).first;
+                } else if (it->second.stack_base != stack_base || it->second.sp != sp) {
+                    for (RegisterState &state : it->second.registers) {
+                        state = { };
+                    }
+                } else {
+                    for (UInt reg = 0; reg < num_tracked_registers; reg++) {
+                        it->second.registers[reg].Meet(registers[reg]);
+                    }
+                }
+
+                it->second.num_jumps++;
+            }
+
+            // the fall-through path continues with what is known
+            if (jump->jump_class == Jump::JMP) {
+                is_reachable = false;
+            }
+
+            continue;
+        }
+
+        if (dynamic_cast<Comment *>(buildable)) {
+            Remove(ref);
+            num_removed++;
+
+            continue;
+        }
+
+        const BytecodeOptimizerEffect effect = GetEffect(buildable);
+
+        if (effect.is_barrier) {
+            Reset();
+
+            continue;
+        }
+
+        Bool redundant = false;
+        Bool handled = true;
+
+        if (auto *constant = dynamic_cast<ConstI32 *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_I32, constant->value));
+        } else if (auto *constant = dynamic_cast<ConstI64 *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_I64, constant->value));
+        } else if (auto *constant = dynamic_cast<ConstU32 *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_U32, constant->value));
+        } else if (auto *constant = dynamic_cast<ConstU64 *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_U64, constant->value));
+        } else if (auto *constant = dynamic_cast<ConstF32 *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_F32, constant->value));
+        } else if (auto *constant = dynamic_cast<ConstF64 *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_F64, constant->value));
+        } else if (auto *constant = dynamic_cast<ConstBool *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_BOOL, UInt8(constant->value)));
+        } else if (auto *constant = dynamic_cast<ConstNull *>(buildable)) {
+            redundant = Load(constant->reg, RegisterState::Constant(RegisterState::CONSTANT_NULL, UInt8(0)));
+        } else if (auto *storage = dynamic_cast<StorageOperation *>(buildable)) {
+            if (storage->operation == Operations::STORE) {
+                // a store may write through a reference held in the destination,
+                // so it can change any slot or static object
+                ForgetMemory();
+            } else if (storage->method == Methods::LOCAL || storage->method == Methods::STATIC) {
+                RegisterState loaded;
+
+                if (storage->method == Methods::STATIC) {
+                    loaded.static_index = Int(storage->op.b.index);
+                } else if (storage->strategy == Strategies::BY_OFFSET) {
+                    loaded.has_slot = true;
+                    loaded.slot = sp - Int(storage->op.b.offset);
+                } else {
+                    loaded.stack_index = Int(storage->op.b.index);
+                }
+
+                redundant = Load(storage->op.a.reg, loaded);
+            } else {
+                handled = false;
+            }
+        } else if (auto *operation = dynamic_cast<RawOperation<> *>(buildable)) {
+            switch (operation->opcode) {
+            case PUSH: {
+                const RegIndex reg = ReadOperand<RegIndex>(operation, 0);
+
+                registers[reg].has_slot = true;
+                registers[reg].slot = sp++;
+
+                break;
+            }
+            case POP:
+                ShrinkStack(sp - 1);
+
+                break;
+            case ADD_SP:
+                sp += Int(ReadOperand<UInt16>(operation, 0));
+
+                break;
+            case SUB_SP:
+                ShrinkStack(sp - Int(ReadOperand<UInt16>(operation, 0)));
+
+                break;
+            case LOAD_OFFSET: {
+                RegisterState loaded;
+                loaded.has_slot = true;
+                loaded.slot = sp - Int(ReadOperand<UInt16>(operation, sizeof(RegIndex)));
+
+                redundant = Load(ReadOperand<RegIndex>(operation, 0), loaded);
+
+                break;
+            }
+            case MOV_REG: {
+                const RegIndex dst = ReadOperand<RegIndex>(operation, 0);
+                const RegIndex src = ReadOperand<RegIndex>(operation, sizeof(RegIndex));
+
+                if (dst == src || registers[dst].HoldsSameValueAs(registers[src])) {
+                    redundant = true;
+                } else {
+                    registers[dst] = registers[src];
+                }
+
+                break;
+            }
+            default:
+                handled = false;
+
+                break;
+            }
+        } else {
+            handled = false;
+        }
+
+        if (redundant) {
+            Remove(ref);
+            num_removed++;
+
+            continue;
+        }
+
+        if (!handled) {
+            for (UInt reg = 0; reg < num_tracked_registers; reg++) {
+                if (effect.writes & (1u << reg)) {
+                    registers[reg] = { };
+                }
+            }
+        }
+    }
+
+    return num_removed;
+}
+
+SizeType BytecodeOptimizer::BackwardPass(const Range &range)
+{
+    // registers that may be read before they are next written
+    UInt32 live = all_registers_mask;
+
+    SizeType num_removed = 0;
+
+    for (SizeType index = range.end; index != range.begin; index--) {
+        const InstructionRef &ref = m_instructions[index - 1];
+        Buildable *buildable = ref.Get();
+
+        if (buildable == nullptr) {
+            // already removed
+            continue;
+        }
+
+        if (dynamic_cast<Jump *>(buildable)) {
+            live = all_registers_mask;
+
+            continue;
+        }
+
+        const BytecodeOptimizerEffect effect = GetEffect(buildable);
+
+        if (effect.is_barrier) {
+            live = all_registers_mask;
+
+            continue;
+        }
+
+        if (effect.is_pure && effect.writes != 0 && !(live & effect.writes)) {
+            Remove(ref);
+            num_removed++;
+
+            continue;
+        }
+
+        live = (live & ~effect.writes) | effect.reads;
+    }
+
+    return num_removed;
+}
+
+void BytecodeOptimizer::Remove(const InstructionRef &ref)
+{
+    AssertThrow(ref.Get() != nullptr);
+
+    ref.chunk->buildables[ref.index].reset();
+}
+
+void BytecodeOptimizer::Compact(BytecodeChunk *chunk)
+{
+    Array<std::unique_ptr<Buildable>> buildables;
+    buildables.Reserve(chunk->buildables.Size());
+
+    for (std::unique_ptr<Buildable> &buildable : chunk->buildables) {
+        if (buildable == nullptr) {
+            continue;
+        }
+
+        if (auto *nested = dynamic_cast<BytecodeChunk *>(buildable.get())) {
+            Compact(nested);
+        }
+
+        buildables.PushBack(std::move(buildable));
+    }
+
+    chunk->buildables = std::move(buildables);
+}
+
+} // namespace hyperion::compiler
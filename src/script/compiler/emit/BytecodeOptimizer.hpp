@@ -0,0 +1,90 @@
+#ifndef BYTECODE_OPTIMIZER_HPP
+#define BYTECODE_OPTIMIZER_HPP
+
+#include <script/compiler/emit/BytecodeChunk.hpp>
+
+#include <core/lib/DynArray.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion::compiler {
+
+/*! \brief Removes redundant instructions from a built BytecodeChunk, before code generation.
+
+    The chunk is flattened into one instruction list. Walking forward through it, the optimizer tracks
+    what each register holds (a stack slot, a static object or a constant), and the following are removed:
+     - loads of a value the destination register already holds
+     - register moves between registers that hold the same value
+     - register writes that are overwritten before they are read
+     - comments, which would otherwise be executed as REM instructions
+
+    Any instruction the optimizer does not model is treated as a barrier that reads every register and
+    clobbers everything that is known.
+
+    What is known is carried across jumps: at a label, it is what all the paths reaching the label agree on,
+    as long as every jump to the label comes before it, and the label is not otherwise entered (as the start
+    of a function body, or a catch block). Labels that are the target of a backward jump, such as loop heads,
+    start again with nothing known.
+
+    Nothing is carried across a label that directly follows a jump (such as the start of each function
+    body) in either direction, so for large chunks the instruction list is cut into ranges at those
+    points, and the ranges are optimized on separate threads. */
+class BytecodeOptimizer
+{
+public:
+    struct InstructionRef
+    {
+        BytecodeChunk   *chunk;
+        SizeType        index;
+
+        Buildable *Get() const
+            { return chunk->buildables[index].get(); }
+    };
+
+    BytecodeOptimizer() = default;
+    BytecodeOptimizer(const BytecodeOptimizer &other) = delete;
+    BytecodeOptimizer &operator=(const BytecodeOptimizer &other) = delete;
+    ~BytecodeOptimizer() = default;
+
+    /*! \brief Returns the number of instructions that were removed. */
+    SizeType GetNumRemoved() const
+        { return m_num_removed; }
+
+    void Optimize(BytecodeChunk *chunk);
+
+private:
+    struct Range
+    {
+        SizeType    begin;
+        SizeType    end;
+    };
+
+    struct LabelUse
+    {
+        // number of jumps to the label
+        UInt32      num_jumps = 0;
+        // the label is also entered other than by a jump
+        Bool        is_entry = false;
+    };
+
+    void Flatten(BytecodeChunk *chunk);
+    void FindLabelUses();
+
+    LabelUse GetLabelUse(LabelId label_id) const
+        { return label_id < m_label_uses.Size() ? m_label_uses[label_id] : LabelUse { }; }
+    Array<Range> Split(UInt max_ranges) const;
+    // each pass returns the number of instructions it removed
+    SizeType ForwardPass(const Range &range);
+    SizeType BackwardPass(const Range &range);
+    static void Remove(const InstructionRef &ref);
+    void Compact(BytecodeChunk *chunk);
+
+    Array<InstructionRef>   m_instructions;
+    // indexed by label id
+    Array<LabelUse>         m_label_uses;
+    SizeType                m_num_removed = 0;
+};
+
+} // namespace hyperion::compiler
+
+#endif
@@ -2,5 +2,25 @@
 #include <script/compiler/emit/Instruction.hpp>
 #include <script/compiler/emit/BytecodeChunk.hpp>
 #include <script/compiler/emit/StorageOperation.hpp>
+#include <script/compiler/Configuration.hpp>
+
+#include <math/MathUtil.hpp>
 
 #include <system/Debug.hpp>
+
+namespace hyperion::compiler {
+
+UInt BytecodeUtil::GetNumCodegenWorkers(SizeType num_instructions)
+{
+    UInt num_workers = Config::codegen_num_workers;
+
+    if (num_workers == 0) {
+        num_workers = MathUtil::Max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    const SizeType max_workers = num_instructions / MathUtil::Max(Config::min_instructions_per_codegen_worker, SizeType(1));
+
+    return UInt(MathUtil::Max(MathUtil::Min(SizeType(num_workers), max_workers), SizeType(1)));
+}
+
+} // namespace hyperion::compiler
@@ -1,9 +1,14 @@
 #ifndef BYTECODE_UTIL_HPP
 #define BYTECODE_UTIL_HPP
 
+#include <core/lib/DynArray.hpp>
+
+#include <Types.hpp>
+
 #include <memory>
 #include <sstream>
 #include <vector>
+#include <thread>
 #include <cstdint>
 
 namespace hyperion::compiler {
@@ -22,6 +27,29 @@ public:
         static_assert(std::is_base_of<Buildable, T>::value, "Must be a Buildable type.");
         return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
     }
+
+    /*! \brief Returns how many threads work on \ref{num_instructions} instructions should be split across,
+        according to Config::codegen_num_workers and Config::min_instructions_per_codegen_worker. */
+    static UInt GetNumCodegenWorkers(SizeType num_instructions);
+
+    /*! \brief Calls \ref{function} with each worker index in [0, num_workers), each on its own thread,
+        and returns once all calls have returned. Worker 0 runs on the calling thread. */
+    template <class Function>
+    static void RunWorkers(UInt num_workers, Function &&function)
+    {
+        Array<std::thread> threads;
+        threads.Reserve(num_workers);
+
+        for (UInt worker_index = 1; worker_index < num_workers; worker_index++) {
+            threads.PushBack(std::thread(function, worker_index));
+        }
+
+        function(UInt(0));
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
 };
 
 } // namespace hyperion::compiler
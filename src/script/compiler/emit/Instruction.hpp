@@ -284,12 +284,15 @@ struct ConstNull : public Buildable
 struct BuildableTryCatch final : public Buildable
 {
     LabelId catch_label_id;
+    LabelId end_label_id; // marks the end of the try block
+    UInt32  stack_depth;  // stack size relative to the current frame when entering the try block
 };
 
 struct BuildableFunction final : public Buildable
 {
     RegIndex reg;
     LabelId label_id;
+    LabelId end_label_id; // marks the end of the function body
     uint8_t nargs;
     uint8_t flags;
 };
@@ -15,6 +15,8 @@ InstructionStream::InstructionStream()
     : //m_position(0),
       m_register_counter(0),
       m_stack_size(0),
+      m_frame_base_stack_size(0),
+      m_frame_num_args(0),
       m_static_id(0)
 {
 }
@@ -24,6 +26,8 @@ InstructionStream::InstructionStream(const InstructionStream &other)
       //m_data(other.m_data),
       m_register_counter(other.m_register_counter),
       m_stack_size(other.m_stack_size),
+      m_frame_base_stack_size(other.m_frame_base_stack_size),
+      m_frame_num_args(other.m_frame_num_args),
       m_static_id(other.m_static_id),
       m_static_objects(other.m_static_objects)
 {
@@ -121,8 +121,26 @@ public:
         return --m_stack_size;
     }
 
+    /*! \brief The stack size at the start of the frame of the function being built,
+        i.e. just above its call info. 0 for top level code. */
+    Int GetFrameBaseStackSize() const
+        { return m_frame_base_stack_size; }
+
+    void SetFrameBaseStackSize(Int frame_base_stack_size)
+        { m_frame_base_stack_size = frame_base_stack_size; }
+
+    /*! \brief The number of arguments below the call info of the function being built. */
+    Int GetFrameNumArgs() const
+        { return m_frame_num_args; }
+
+    void SetFrameNumArgs(Int frame_num_args)
+        { m_frame_num_args = frame_num_args; }
+
     Int NewStaticId() { return m_static_id++; }
 
+    /*! \brief The number of static ids handed out so far */
+    Int GetNumStaticIds() const { return m_static_id; }
+
     void AddStaticObject(const StaticObject &static_object)
         { m_static_objects.PushBack(static_object); }
 
@@ -141,6 +159,10 @@ private:
     // incremented each time a variable is pushed,
     // decremented each time a stack frame is closed
     Int                                 m_stack_size;
+    // stack size at the start of the current function's frame
+    Int                                 m_frame_base_stack_size;
+    // number of arguments of the current function
+    Int                                 m_frame_num_args;
     // the current static object id
     Int                                 m_static_id;
 
@@ -1,4 +1,5 @@
 #include <script/compiler/emit/codegen/CodeGenerator.hpp>
+#include <script/compiler/emit/BytecodeUtil.hpp>
 #include <script/Hasher.hpp>
 #include <iostream>
 
@@ -9,43 +10,97 @@ CodeGenerator::CodeGenerator(BuildParams &build_params)
 {
 }
 
-void CodeGenerator::Visit(BytecodeChunk *chunk)
+static void ReserveLabel(BuildParams &build_params, LabelId label_id)
 {
-    BuildParams new_params;
-    new_params.block_offset = build_params.block_offset + m_ibs.GetPosition();
-    new_params.labels       = build_params.labels;
+    while (build_params.labels.Size() <= label_id) {
+        build_params.labels.PushBack(LabelPosition(-1));
+    }
+}
 
+void CodeGenerator::Visit(BytecodeChunk *chunk)
+{
+    // nested chunks are emitted straight into this stream; labels are
+    // resolved by id through the flat table, so nothing needs to be copied.
     for (const LabelId label_id : chunk->labels) {
-        new_params.labels.Insert({
-            label_id,
-            LabelPosition(-1),
-            HYP_NAME(LabelNameRemoved)
-        });
+        ReserveLabel(build_params, label_id);
     }
 
-    CodeGenerator code_generator(new_params);
+    for (auto &buildable : chunk->buildables) {
+        BuildableVisitor::Visit(buildable.get());
+    }
+}
+
+void CodeGenerator::Flatten(BytecodeChunk *chunk, Array<Buildable *> &out_buildables)
+{
+    for (const LabelId label_id : chunk->labels) {
+        ReserveLabel(build_params, label_id);
+    }
 
     for (auto &buildable : chunk->buildables) {
-        code_generator.BuildableVisitor::Visit(buildable.get());
+        if (auto *nested = dynamic_cast<BytecodeChunk *>(buildable.get())) {
+            Flatten(nested, out_buildables);
+
+            continue;
+        }
+
+        out_buildables.PushBack(buildable.get());
     }
+}
+
+void CodeGenerator::Generate(BytecodeChunk *chunk)
+{
+    Array<Buildable *> buildables;
+    Flatten(chunk, buildables);
 
-    // bake the chunk's byte stream
-    //code_generator.GetInternalByteStream().Bake(new_params);
+    const UInt num_workers = BytecodeUtil::GetNumCodegenWorkers(buildables.Size());
+
+    if (num_workers <= 1) {
+        for (Buildable *buildable : buildables) {
+            BuildableVisitor::Visit(buildable);
+        }
 
-    const Array<UByte> &bytes = code_generator.GetInternalByteStream().GetData();
-    const Array<Fixup> &fixups = code_generator.GetInternalByteStream().GetFixups();
+        return;
+    }
 
-    const SizeType fixup_offset = m_ibs.GetPosition();
+    // each worker marks labels relative to the start of its own stream
+    Array<BuildParams> worker_build_params;
+    worker_build_params.Resize(num_workers);
 
-    // append bytes to this chunk's InternalByteStream
-    m_ibs.Put(bytes.Data(), bytes.Size());
+    Array<std::unique_ptr<CodeGenerator>> workers;
+    workers.Reserve(num_workers);
 
-    // Copy fixups from the chunk's InternalByteStream to this one's
-    for (const Fixup &fixup : fixups) {
-        m_ibs.AddFixup(fixup.label_id, fixup.position + fixup_offset, fixup.offset);
+    for (UInt worker_index = 0; worker_index < num_workers; worker_index++) {
+        workers.PushBack(std::make_unique<CodeGenerator>(worker_build_params[worker_index]));
     }
 
-    build_params.labels = new_params.labels;
+    BytecodeUtil::RunWorkers(num_workers, [&buildables, &workers, num_workers](UInt worker_index)
+    {
+        const SizeType begin = buildables.Size() * worker_index / num_workers;
+        const SizeType end = buildables.Size() * (worker_index + 1) / num_workers;
+
+        for (SizeType index = begin; index < end; index++) {
+            workers[worker_index]->BuildableVisitor::Visit(buildables[index]);
+        }
+    });
+
+    for (UInt worker_index = 0; worker_index < num_workers; worker_index++) {
+        const Array<LabelPosition> &worker_labels = worker_build_params[worker_index].labels;
+        const SizeType base_position = m_ibs.GetPosition() + build_params.block_offset;
+
+        for (LabelId label_id = 0; label_id < worker_labels.Size(); label_id++) {
+            if (worker_labels[label_id] == LabelPosition(-1)) {
+                continue;
+            }
+
+            ReserveLabel(build_params, label_id);
+
+            AssertThrowMsg(build_params.labels[label_id] == LabelPosition(-1), "Label position already set");
+
+            build_params.labels[label_id] = LabelPosition(worker_labels[label_id] + base_position);
+        }
+
+        m_ibs.Append(std::move(workers[worker_index]->m_ibs));
+    }
 }
 
 void CodeGenerator::Bake()
@@ -57,16 +112,11 @@ void CodeGenerator::Visit(LabelMarker *node)
 {
     const LabelId label_id = node->id;
 
-    const auto it = build_params.labels.FindIf([label_id](const LabelInfo &label_info)
-    {
-        return label_info.label_id == label_id;
-    });
-
-    AssertThrowMsg(it != build_params.labels.End(), "Label with ID %d not found", label_id);
+    ReserveLabel(build_params, label_id);
 
-    AssertThrowMsg(it->position == LabelPosition(-1), "Label position already set");
+    AssertThrowMsg(build_params.labels[label_id] == LabelPosition(-1), "Label position already set");
 
-    it->position = LabelPosition(m_ibs.GetPosition() + build_params.block_offset);
+    build_params.labels[label_id] = LabelPosition(m_ibs.GetPosition() + build_params.block_offset);
 }
 
 void CodeGenerator::Visit(Jump *node)
@@ -214,8 +264,13 @@ void CodeGenerator::Visit(ConstNull *node)
 
 void CodeGenerator::Visit(BuildableTryCatch *node)
 {
-    m_ibs.Put(Instructions::BEGIN_TRY);
-    m_ibs.AddFixup(node->catch_label_id, build_params.block_offset);
+    // no instruction is emitted; the try block is recorded in the exception table
+    m_ibs.AddExceptionRange(ExceptionRange {
+        .begin          = m_ibs.GetPosition(),
+        .end_label_id   = node->end_label_id,
+        .catch_label_id = node->catch_label_id,
+        .stack_depth    = node->stack_depth
+    });
 }
 
 void CodeGenerator::Visit(BuildableFunction *node)
@@ -226,6 +281,12 @@ void CodeGenerator::Visit(BuildableFunction *node)
     m_ibs.AddFixup(node->label_id, build_params.block_offset);
     m_ibs.Put(node->nargs);
     m_ibs.Put(node->flags);
+
+    // the body is emitted inline, but does not run in this frame
+    m_ibs.AddFunctionBody(FunctionBody {
+        .begin_label_id = node->label_id,
+        .end_label_id   = node->end_label_id
+    });
 }
 
 void CodeGenerator::Visit(BuildableType *node)
@@ -23,6 +23,13 @@ public:
     InternalByteStream &GetInternalByteStream() { return m_ibs; }
     const InternalByteStream &GetInternalByteStream() const { return m_ibs; }
 
+    /*! \brief Emits the chunk and everything nested in it, like Visit(BytecodeChunk *).
+        Large chunks are flattened and cut into consecutive ranges of instructions, each emitted
+        into its own stream on a separate thread. The streams are then appended in order, and the
+        labels marked in each are placed at the offset its bytes ended up at. Jumps are resolved
+        by Bake() as usual, so the result is the same as emitting on one thread. */
+    void Generate(BytecodeChunk *chunk);
+
     void Bake();
 
     virtual void Visit(BytecodeChunk *);
@@ -54,6 +61,8 @@ public:
     virtual void Visit(RawOperation<> *);
 
 private:
+    void Flatten(BytecodeChunk *chunk, Array<Buildable *> &out_buildables);
+
     BuildParams &build_params;
     InternalByteStream m_ibs;
 };
@@ -2,6 +2,7 @@
 
 #include <system/Debug.hpp>
 #include <iostream>
+#include <algorithm>
 
 namespace hyperion::compiler {
 
@@ -38,20 +39,61 @@ void InternalByteStream::AddFixup(LabelId label_id, SizeType offset)
     AddFixup(label_id, position, offset);
 }
 
-void InternalByteStream::Bake(const BuildParams &build_params)
+void InternalByteStream::AddExceptionRange(const ExceptionRange &exception_range)
 {
+    m_exception_ranges.PushBack(exception_range);
+}
 
-    for (const Fixup &fixup : m_fixups) {
-        auto it = build_params.labels.FindIf([label_id = fixup.label_id](const LabelInfo &label_info)
-        {
-            return label_info.label_id == label_id;
-        });
+void InternalByteStream::AddFunctionBody(const FunctionBody &function_body)
+{
+    m_function_bodies.PushBack(function_body);
+}
+
+void InternalByteStream::Append(InternalByteStream &&other)
+{
+    const SizeType base_position = m_stream.Size();
 
-        AssertThrowMsg(it != build_params.labels.End(), "No label with fixup ID was found");
+    Put(other.m_stream.Data(), other.m_stream.Size());
 
-        LabelPosition label_position = it->position;
-        AssertThrowMsg(label_position != LabelPosition(-1), "Label position not set!");
-        //label_position += fixup.offset;
+    m_fixups.Reserve(m_fixups.Size() + other.m_fixups.Size());
+
+    for (Fixup fixup : other.m_fixups) {
+        fixup.position += base_position;
+
+        m_fixups.PushBack(fixup);
+    }
+
+    for (ExceptionRange exception_range : other.m_exception_ranges) {
+        exception_range.begin += base_position;
+
+        m_exception_ranges.PushBack(exception_range);
+    }
+
+    // function bodies are only referred to by label, nothing to move
+    for (const FunctionBody &function_body : other.m_function_bodies) {
+        m_function_bodies.PushBack(function_body);
+    }
+
+    other.m_stream.Clear();
+    other.m_fixups.Clear();
+    other.m_exception_ranges.Clear();
+    other.m_function_bodies.Clear();
+}
+
+LabelPosition InternalByteStream::FindLabelPosition(const BuildParams &build_params, LabelId label_id)
+{
+    AssertThrowMsg(label_id < build_params.labels.Size(), "No label with fixup ID was found");
+
+    const LabelPosition label_position = build_params.labels[label_id];
+    AssertThrowMsg(label_position != LabelPosition(-1), "Label position not set!");
+
+    return label_position;
+}
+
+void InternalByteStream::Bake(const BuildParams &build_params)
+{
+    for (const Fixup &fixup : m_fixups) {
+        const LabelPosition label_position = FindLabelPosition(build_params, fixup.label_id);
 
         const SizeType fixup_position = fixup.position;
         
@@ -68,6 +110,71 @@ void InternalByteStream::Bake(const BuildParams &build_params)
 
     // clear fixups vector, no more work to do
     m_fixups.Clear();
+
+    // resolve the function bodies, sorted by begin address. nested bodies are
+    // skipped, as cutting out the body enclosing them already removes them.
+    Array<vm::ExceptionTableEntry> function_bodies;
+    function_bodies.Reserve(m_function_bodies.Size());
+
+    for (const FunctionBody &function_body : m_function_bodies) {
+        function_bodies.PushBack(vm::ExceptionTableEntry {
+            .begin  = vm::BCAddress(FindLabelPosition(build_params, function_body.begin_label_id)),
+            .end    = vm::BCAddress(FindLabelPosition(build_params, function_body.end_label_id))
+        });
+    }
+
+    std::sort(function_bodies.Begin(), function_bodies.End(), [](const vm::ExceptionTableEntry &lhs, const vm::ExceptionTableEntry &rhs)
+    {
+        return lhs.begin < rhs.begin;
+    });
+
+    m_exception_table_entries.Clear();
+    m_exception_table_entries.Reserve(m_exception_ranges.Size());
+
+    for (const ExceptionRange &exception_range : m_exception_ranges) {
+        vm::ExceptionTableEntry entry {
+            .begin          = vm::BCAddress(exception_range.begin + build_params.block_offset),
+            .end            = vm::BCAddress(FindLabelPosition(build_params, exception_range.end_label_id)),
+            .catch_address  = vm::BCAddress(FindLabelPosition(build_params, exception_range.catch_label_id)),
+            .stack_depth    = exception_range.stack_depth
+        };
+
+        // a function defined inside the try block has its body emitted inline, but an exception
+        // thrown from it must unwind its own frame first; so split the range around every such body.
+        const vm::ExceptionTableEntry *it = std::lower_bound(function_bodies.Begin(), function_bodies.End(), entry.begin, [](const vm::ExceptionTableEntry &function_body, vm::BCAddress address)
+        {
+            return function_body.begin < address;
+        });
+
+        for (; it != function_bodies.End() && it->begin < entry.end; ++it) {
+            if (it->begin < entry.begin || it->end > entry.end) {
+                continue; // nested in a body that has already been cut out
+            }
+
+            if (it->begin > entry.begin) {
+                vm::ExceptionTableEntry piece = entry;
+                piece.end = it->begin;
+
+                m_exception_table_entries.PushBack(piece);
+            }
+
+            entry.begin = it->end;
+        }
+
+        if (entry.begin < entry.end) {
+            m_exception_table_entries.PushBack(entry);
+        }
+    }
+
+    // pieces of an enclosing range may now follow the ranges nested in it,
+    // a stable sort keeps enclosing ranges that begin at the same address first
+    std::stable_sort(m_exception_table_entries.Begin(), m_exception_table_entries.End(), [](const vm::ExceptionTableEntry &lhs, const vm::ExceptionTableEntry &rhs)
+    {
+        return lhs.begin < rhs.begin;
+    });
+
+    m_function_bodies.Clear();
+    m_exception_ranges.Clear();
 }
 
 } // namespace hyperion::compiler
@@ -2,6 +2,8 @@
 #define INTERNAL_BYTE_STREAM_HPP
 
 #include <script/compiler/emit/Buildable.hpp>
+#include <script/vm/ExceptionTable.hpp>
+#include <core/lib/CMemory.hpp>
 #include <Types.hpp>
 
 #include <map>
@@ -18,6 +20,22 @@ struct Fixup
     SizeType    offset = SizeType(-1);
 };
 
+struct ExceptionRange
+{
+    SizeType    begin = SizeType(-1);
+    LabelId     end_label_id = LabelId(-1);
+    LabelId     catch_label_id = LabelId(-1);
+    UInt32      stack_depth = 0;
+};
+
+/*! \brief A function body emitted inline in the stream. Exception ranges
+    that enclose it are cut around it, as the body runs in its own frame. */
+struct FunctionBody
+{
+    LabelId     begin_label_id = LabelId(-1);
+    LabelId     end_label_id = LabelId(-1);
+};
+
 class InternalByteStream
 {
 public:
@@ -30,25 +48,47 @@ public:
     const Array<Fixup> &GetFixups() const
         { return m_fixups; }
 
+    const Array<ExceptionRange> &GetExceptionRanges() const
+        { return m_exception_ranges; }
+
+    /*! \brief The resolved exception ranges, only valid after Bake() */
+    const Array<vm::ExceptionTableEntry> &GetExceptionTableEntries() const
+        { return m_exception_table_entries; }
+
     void Put(UByte byte)
         { m_stream.PushBack(byte); }
 
     void Put(const UByte *bytes, SizeType size)
     {
-        for (SizeType i = 0; i < size; i++) {
-            m_stream.PushBack(bytes[i]);
+        if (size == 0) {
+            return;
         }
+
+        const SizeType previous_size = m_stream.Size();
+        m_stream.Resize(previous_size + size);
+        Memory::MemCpy(m_stream.Data() + previous_size, bytes, size);
     }
 
     void MarkLabel(LabelId label_id);
     void AddFixup(LabelId label_id, SizeType position, SizeType offset);
     void AddFixup(LabelId label_id, SizeType offset);
+    void AddExceptionRange(const ExceptionRange &exception_range);
+    void AddFunctionBody(const FunctionBody &function_body);
+
+    /*! \brief Moves the contents of \ref{other} to the end of this stream. Its fixups, exception ranges
+        and function bodies are moved along with it, to the positions its bytes end up at. */
+    void Append(InternalByteStream &&other);
 
     void Bake(const BuildParams &build_params);
 
 private:
-    Array<UByte> m_stream;
-    Array<Fixup> m_fixups;
+    static LabelPosition FindLabelPosition(const BuildParams &build_params, LabelId label_id);
+
+    Array<UByte>                    m_stream;
+    Array<Fixup>                    m_fixups;
+    Array<ExceptionRange>           m_exception_ranges;
+    Array<FunctionBody>             m_function_bodies;
+    Array<vm::ExceptionTableEntry>  m_exception_table_entries;
 };
 
 } // namespace hyperion::compiler
@@ -6,6 +6,8 @@
 #include <script/compiler/ast/AstString.hpp>
 #include <script/compiler/ast/AstFunctionExpression.hpp>
 
+#include <script/compiler/Configuration.hpp>
+
 #include <core/lib/FlatSet.hpp>
 
 #include <system/Debug.hpp>
@@ -13,6 +15,9 @@
 
 namespace hyperion::compiler {
 
+// starts at 1 so that a revision of 0 never matches
+std::atomic<UInt32> SymbolType::s_revision { 1u };
+
 SymbolType::SymbolType(
     const String &name, 
     SymbolTypeClass type_class, 
@@ -22,7 +27,10 @@ SymbolType::SymbolType(
     m_default_value(nullptr),
     m_base(base),
     m_id(-1),
-    m_flags(SYMBOL_TYPE_FLAGS_NONE)
+    m_flags(SYMBOL_TYPE_FLAGS_NONE),
+    m_hash_code_sequence(0),
+    m_hash_code_revision(0),
+    m_hash_code_value(0)
 {
 }
 
@@ -38,8 +46,12 @@ SymbolType::SymbolType(
     m_members(members),
     m_base(base),
     m_id(-1),
-    m_flags(SYMBOL_TYPE_FLAGS_NONE)
+    m_flags(SYMBOL_TYPE_FLAGS_NONE),
+    m_hash_code_sequence(0),
+    m_hash_code_revision(0),
+    m_hash_code_value(0)
 {
+    BuildMemberIndex();
 }
 
 bool SymbolType::TypeEqual(const SymbolType &other) const
@@ -48,7 +60,6 @@ bool SymbolType::TypeEqual(const SymbolType &other) const
         return true;
     }
 
-
     return GetHashCode() == other.GetHashCode();
 
     if (m_name != other.m_name) {
@@ -281,47 +292,136 @@ bool SymbolType::TypeCompatible(
     return true;
 }
 
-const SymbolTypePtr_t SymbolType::FindMember(const String &name) const
+HashCode SymbolType::GetHashCode() const
 {
-    for (const SymbolTypeMember &member : m_members) {
-        if (member.name == name) {
-            return member.type;
+    const UInt32 revision = s_revision.load(std::memory_order_acquire);
+    UInt32 sequence = m_hash_code_sequence.load(std::memory_order_acquire);
+
+    if (!(sequence & 1u)) {
+        const UInt32 cached_revision = m_hash_code_revision.load(std::memory_order_relaxed);
+        const HashCode::ValueType cached_value = m_hash_code_value.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (cached_revision == revision && m_hash_code_sequence.load(std::memory_order_relaxed) == sequence) {
+            return HashCode(cached_value);
         }
     }
 
-    return nullptr;
+    FlatSet<String> duplicate_names;
+    const HashCode hash_code = GetHashCodeWithDuplicateRemoval(duplicate_names);
+
+    // publish it, unless another thread is already doing so
+    if (!(sequence & 1u) && m_hash_code_sequence.compare_exchange_strong(sequence, sequence + 1u, std::memory_order_acquire)) {
+        m_hash_code_revision.store(revision, std::memory_order_relaxed);
+        m_hash_code_value.store(hash_code.Value(), std::memory_order_relaxed);
+        m_hash_code_sequence.store(sequence + 2u, std::memory_order_release);
+    }
+
+    return hash_code;
 }
 
-bool SymbolType::FindMember(const String &name, SymbolTypeMember &out) const
+void SymbolType::BuildMemberIndex()
 {
-    for (const SymbolTypeMember &member : m_members) {
-        if (member.name == name) {
-            out = member;
-            return true;
-        }
+    m_member_index.Clear();
+
+    if (m_members.Size() < Config::min_indexed_members) {
+        return;
     }
 
-    return false;
+    for (SizeType i = 0; i < m_members.Size(); i++) {
+        // keep the first member with a given name
+        m_member_index.Insert(m_members[i].name.GetHashCode().Value(), Int(i));
+    }
 }
 
-bool SymbolType::FindMember(const String &name, SymbolTypeMember &out, UInt &out_index) const
+void SymbolType::IndexMember(SizeType index)
 {
-    // get member index from name
-    for (SizeType i = 0; i < m_members.Size(); i++) {
-        const SymbolTypeMember &member = m_members[i];
+    if (m_members.Size() < Config::min_indexed_members) {
+        return;
+    }
 
-        if (member.name == name) {
-            // only set m_found_index if found in first level.
-            // for members from base objects,
-            // we load based on hash.
-            out_index = UInt(i);
-            out = member;
+    if (m_members.Size() == Config::min_indexed_members) {
+        BuildMemberIndex();
 
-            return true;
+        return;
+    }
+
+    m_member_index.Insert(m_members[index].name.GetHashCode().Value(), Int(index));
+}
+
+Int SymbolType::FindMemberIndex(const String &name) const
+{
+    // small member lists are faster to scan than to index
+    if (m_members.Size() < Config::min_indexed_members) {
+        for (SizeType i = 0; i < m_members.Size(); i++) {
+            if (m_members[i].name == name) {
+                return Int(i);
+            }
         }
+
+        return -1;
     }
 
-    return false;
+    const auto it = m_member_index.Find(name.GetHashCode().Value());
+
+    if (it == m_member_index.End()) {
+        return -1;
+    }
+
+    if (m_members[it->second].name == name) {
+        return it->second;
+    }
+
+    // hash collision with a different name; fall back to a scan
+    for (SizeType i = 0; i < m_members.Size(); i++) {
+        if (m_members[i].name == name) {
+            return Int(i);
+        }
+    }
+
+    return -1;
+}
+
+const SymbolTypePtr_t SymbolType::FindMember(const String &name) const
+{
+    const Int index = FindMemberIndex(name);
+
+    if (index == -1) {
+        return nullptr;
+    }
+
+    return m_members[index].type;
+}
+
+bool SymbolType::FindMember(const String &name, SymbolTypeMember &out) const
+{
+    const Int index = FindMemberIndex(name);
+
+    if (index == -1) {
+        return false;
+    }
+
+    out = m_members[index];
+
+    return true;
+}
+
+bool SymbolType::FindMember(const String &name, SymbolTypeMember &out, UInt &out_index) const
+{
+    const Int index = FindMemberIndex(name);
+
+    if (index == -1) {
+        return false;
+    }
+
+    // only set m_found_index if found in first level.
+    // for members from base objects,
+    // we load based on hash.
+    out_index = UInt(index);
+    out = m_members[index];
+
+    return true;
 }
 
 bool SymbolType::FindMemberDeep(const String &name, SymbolTypeMember &out) const
@@ -415,29 +515,37 @@ bool SymbolType::FindPrototypeMemberDeep(const String &name, SymbolTypeMember &o
 
 bool SymbolType::FindPrototypeMember(const String &name, SymbolTypeMember &out, UInt &out_index) const
 {
-    bool found = false;
-
     // for instance members (do it last, so it can be overridden by instances)
     if (SymbolTypePtr_t proto_type = FindMember("$proto")) {
-        // get member index from name
-        for (SizeType i = 0; i < proto_type->GetMembers().Size(); i++) {
-            const SymbolTypeMember &member = proto_type->GetMembers()[i];
+        return proto_type->FindMember(name, out, out_index);
+    }
+
+    return false;
+}
 
-            if (member.name == name) {
-                // only set m_found_index if found in first level.
-                // for members from base objects,
-                // we load based on hash.
-                out_index = UInt(i);
-                out = member;
+Int SymbolType::GetPrototypeSize() const
+{
+    if (m_type_class != TYPE_USER_DEFINED && m_type_class != TYPE_BUILTIN) {
+        return -1;
+    }
 
-                found = true;
+    if (IsProxyClass()) {
+        return -1;
+    }
 
-                break;
-            }
-        }
+    SymbolTypePtr_t proto_type = FindMember("$proto");
+
+    if (proto_type == nullptr) {
+        return -1;
+    }
+
+    proto_type = proto_type->GetUnaliased();
+
+    if (proto_type->IsAnyType() || proto_type->IsPlaceholderType()) {
+        return -1;
     }
 
-    return found;
+    return Int(proto_type->GetMembers().Size());
 }
 
 bool SymbolType::HasTrait(const SymbolTypeTrait &trait) const
@@ -4,10 +4,12 @@
 #include <core/lib/RefCountedPtr.hpp>
 #include <core/lib/DynArray.hpp>
 #include <core/lib/FlatSet.hpp>
+#include <core/lib/FlatMap.hpp>
 #include <core/lib/String.hpp>
 #include <Types.hpp>
 
 #include <memory>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <tuple>
@@ -241,20 +243,17 @@ public:
     void SetDefaultValue(const RC<AstExpression> &default_value)
         { m_default_value = default_value; }
     
-    Array<SymbolTypeMember> &GetMembers()
-        { return m_members; }
-
+    // members, flags, alias and generic info go into the hash code, so they are only
+    // read through const accessors and only changed through the setters below
     const Array<SymbolTypeMember> &GetMembers() const
         { return m_members; }
 
     void SetMembers(const Array<SymbolTypeMember> &members)
-        { m_members = members; }
+        { m_members = members; BuildMemberIndex(); OnChanged(); }
 
     void AddMember(const SymbolTypeMember &member)
-        { m_members.PushBack(member); }
+        { m_members.PushBack(member); IndexMember(m_members.Size() - 1); OnChanged(); }
 
-    AliasTypeInfo &GetAliasInfo()
-        { return m_alias_info; }
     const AliasTypeInfo &GetAliasInfo() const
         { return m_alias_info; }
 
@@ -263,13 +262,9 @@ public:
     const FunctionTypeInfo &GetFunctionInfo() const
         { return m_function_info; }
 
-    GenericTypeInfo &GetGenericInfo()
-        { return m_generic_info; }
     const GenericTypeInfo &GetGenericInfo() const
         { return m_generic_info; }
 
-    GenericInstanceTypeInfo &GetGenericInstanceInfo()
-        { return m_generic_instance_info; }
     const GenericInstanceTypeInfo &GetGenericInstanceInfo() const
         { return m_generic_instance_info; }
 
@@ -282,13 +277,15 @@ public:
     void SetId(int id) { m_id = id; }
 
     SymbolTypeFlags GetFlags() const { return m_flags; }
-    SymbolTypeFlags &GetFlags() { return m_flags; }
-    void SetFlags(SymbolTypeFlags flags) { m_flags = flags; }
+    void SetFlags(SymbolTypeFlags flags) { m_flags = flags; OnChanged(); }
 
     String ToString(Bool include_parameter_names = false) const;
 
     bool IsAlias() const { return m_type_class == TYPE_ALIAS; }
 
+    /*! \brief Two types are equal if they are the same object, or if their canonical hash codes match.
+        The canonical hash code is computed once per type and reused until any type is modified
+        through one of its setters. */
     bool TypeEqual(const SymbolType &other) const;
     bool TypeCompatible(
         const SymbolType &other,
@@ -311,6 +308,11 @@ public:
     bool FindPrototypeMemberDeep(const String &name) const;
     bool FindPrototypeMemberDeep(const String &name, SymbolTypeMember &out) const;
 
+    /*! \brief Returns the number of members an instance gets from the prototype of this type alone
+        (not counting its bases), or -1 if that is not known at compile time. An instance holds the
+        prototype members of its own type first, followed by those of each base type in order. */
+    Int GetPrototypeSize() const;
+
     bool HasTrait(const SymbolTypeTrait &trait) const;
     bool HasTraitDeep(const SymbolTypeTrait &trait) const;
 
@@ -364,12 +366,7 @@ public:
     bool IsProxyClass() const
         { return m_flags & SYMBOL_TYPE_FLAGS_PROXY; }
 
-    HashCode GetHashCode() const
-    {
-        FlatSet<String> duplicate_names;
-
-        return GetHashCodeWithDuplicateRemoval(duplicate_names);
-    }
+    HashCode GetHashCode() const;
 
     // if this is an instance of a generic type
     SymbolTypeClass             m_type_class;
@@ -378,6 +375,21 @@ public:
 private:
     HashCode GetHashCodeWithDuplicateRemoval(FlatSet<String> &duplicate_names) const;
 
+    /*! \brief Returns the index of the first member named \ref{name}, or -1 if there is none. */
+    Int FindMemberIndex(const String &name) const;
+
+    /*! \brief Rebuild the member index from scratch, for types with enough members to need one. */
+    void BuildMemberIndex();
+    /*! \brief Add the member at \ref{index} to the member index, building the index once it is needed. */
+    void IndexMember(SizeType index);
+
+    /*! \brief Invalidates the cached hash code of every type. A type's hash code
+        includes its members' types, so a change to any type may change the hash code of others. */
+    void OnChanged()
+        { s_revision.fetch_add(1u, std::memory_order_acq_rel); }
+
+    static std::atomic<UInt32>  s_revision;
+
     String                      m_name;
     RC<AstExpression>           m_default_value;
     Array<SymbolTypeMember>     m_members;
@@ -398,6 +410,16 @@ private:
 
     int                         m_id;
     SymbolTypeFlags             m_flags;
+
+    // the cached hash code and the revision it was computed at. builtin types are shared by
+    // every CompilationUnit, so the pair is published under a sequence number (odd while being
+    // written), and a reader that sees it change computes the hash code itself.
+    mutable std::atomic<UInt32>                 m_hash_code_sequence;
+    mutable std::atomic<UInt32>                 m_hash_code_revision;
+    mutable std::atomic<HashCode::ValueType>    m_hash_code_value;
+
+    // member name hash -> index in m_members, kept up to date by the setters for types with many members
+    FlatMap<HashCode::ValueType, Int>           m_member_index;
 };
 
 } // namespace hyperion::compiler
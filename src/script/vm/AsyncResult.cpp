@@ -0,0 +1,55 @@
+#include <script/vm/AsyncResult.hpp>
+#include <system/Debug.hpp>
+
+namespace hyperion {
+namespace vm {
+
+void AsyncResult::Complete(const Value &value)
+{
+    Proc<void> on_complete;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        AssertThrowMsg(!m_is_complete.load(std::memory_order_relaxed), "Async result has already been completed");
+
+        m_value = value;
+        m_is_complete.store(true, std::memory_order_release);
+
+        on_complete = std::move(m_on_complete);
+    }
+
+    m_cv.notify_all();
+
+    if (on_complete) {
+        on_complete();
+    }
+}
+
+void AsyncResult::OnComplete(Proc<void> &&proc)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        if (!m_is_complete.load(std::memory_order_relaxed)) {
+            m_on_complete = std::move(proc);
+
+            return;
+        }
+    }
+
+    proc();
+}
+
+Bool AsyncResult::WaitFor(std::chrono::microseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_cv.wait_for(lock, timeout, [this]
+    {
+        return m_is_complete.load(std::memory_order_relaxed);
+    });
+}
+
+} // namespace vm
+} // namespace hyperion
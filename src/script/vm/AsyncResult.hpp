@@ -0,0 +1,68 @@
+#ifndef ASYNC_RESULT_HPP
+#define ASYNC_RESULT_HPP
+
+#include <core/lib/Proc.hpp>
+#include <script/vm/Value.hpp>
+
+#include <Types.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+namespace hyperion {
+namespace vm {
+
+/*! \brief The pending return value of an async native function.
+
+    A native function starts an async call with ExecutionThread::BeginAsync(),
+    hands the returned object to whatever does the work and returns without
+    setting a result. The calling script is parked until Complete() is called,
+    which may happen from any host thread. The completed value is then placed
+    in register 0 as if the native had returned it.
+
+    The value is not seen by the garbage collector until the script resumes,
+    so a heap value must be kept alive by something else until then. */
+class AsyncResult
+{
+public:
+    AsyncResult()                                           = default;
+    AsyncResult(const AsyncResult &other)                   = delete;
+    AsyncResult &operator=(const AsyncResult &other)        = delete;
+    AsyncResult(AsyncResult &&other) noexcept               = delete;
+    AsyncResult &operator=(AsyncResult &&other) noexcept    = delete;
+    ~AsyncResult()                                          = default;
+
+    Bool IsComplete() const
+        { return m_is_complete.load(std::memory_order_acquire); }
+
+    /*! \brief Only valid once IsComplete() returns true. */
+    const Value &GetValue() const
+        { return m_value; }
+
+    /*! \brief Set the result and wake up anything waiting on it.
+        May be called from any thread, but only once. */
+    void Complete(const Value &value);
+
+    /*! \brief Set a function to be called once the result has been completed,
+        e.g. to queue the parked script to be resumed. It is called on the thread
+        that completes the result, or immediately if it has already completed. */
+    void OnComplete(Proc<void> &&proc);
+
+    /*! \brief Block until the result has been completed or the timeout has passed.
+        Returns true if the result has been completed. */
+    Bool WaitFor(std::chrono::microseconds timeout);
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::atomic_bool        m_is_complete { false };
+    Value                   m_value;
+    Proc<void>              m_on_complete;
+};
+
+} // namespace vm
+} // namespace hyperion
+
+#endif
@@ -0,0 +1,48 @@
+#include <script/vm/BindingTable.hpp>
+
+#include <math/MathUtil.hpp>
+
+namespace hyperion {
+namespace vm {
+
+BindingTable::BindingTable(Array<GlobalBinding> globals, Array<ClassBinding> classes)
+    : m_globals(std::move(globals)),
+      m_classes(std::move(classes))
+{
+}
+
+const GlobalBinding *BindingTable::FindGlobal(const String &name) const
+{
+    const auto it = m_globals.FindIf([&name](const GlobalBinding &binding)
+    {
+        return binding.name == name;
+    });
+
+    return it != m_globals.End() ? &*it : nullptr;
+}
+
+const ClassBinding *BindingTable::FindClass(const String &name) const
+{
+    const auto it = m_classes.FindIf([&name](const ClassBinding &binding)
+    {
+        return binding.name == name;
+    });
+
+    return it != m_classes.End() ? &*it : nullptr;
+}
+
+SizeType BindingTable::GetNumNativeFunctions() const
+{
+    SizeType num_native_functions = 0;
+
+    for (const GlobalBinding &binding : m_globals) {
+        if (binding.native_function_index != -1) {
+            num_native_functions = MathUtil::Max(num_native_functions, SizeType(binding.native_function_index) + 1);
+        }
+    }
+
+    return num_native_functions;
+}
+
+} // namespace vm
+} // namespace hyperion
@@ -0,0 +1,69 @@
+#ifndef BINDING_TABLE_HPP
+#define BINDING_TABLE_HPP
+
+#include <core/lib/DynArray.hpp>
+#include <core/lib/String.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion {
+namespace vm {
+
+/*! \brief Where a program expects the host to put one native global. */
+struct GlobalBinding
+{
+    String          name;
+    Int             stack_location;
+    // slot in VMState::m_native_functions that CALL_NATIVE reads, or -1
+    Int             native_function_index;
+};
+
+/*! \brief Where a program expects the host to put one native class object. */
+struct ClassBinding
+{
+    String          name;
+    Int             stack_location;
+    // static memory slot of the class's type
+    Int             static_id;
+    // names of the class object's members, in the order the compiler laid them out
+    Array<String>   member_names;
+};
+
+/*! \brief The slots a program was compiled to read its native globals and classes from.
+    Baked into the Program, so that every VM running it binds a Context the same way,
+    matching definitions by name rather than by the order they were declared in. */
+class BindingTable
+{
+public:
+    BindingTable() = default;
+    BindingTable(Array<GlobalBinding> globals, Array<ClassBinding> classes);
+    BindingTable(const BindingTable &other)                 = default;
+    BindingTable &operator=(const BindingTable &other)      = default;
+    BindingTable(BindingTable &&other) noexcept             = default;
+    BindingTable &operator=(BindingTable &&other) noexcept  = default;
+    ~BindingTable()                                         = default;
+
+    const Array<GlobalBinding> &GetGlobals() const
+        { return m_globals; }
+
+    const Array<ClassBinding> &GetClasses() const
+        { return m_classes; }
+
+    /*! \brief Returns nullptr if the program was not compiled with a global of that name. */
+    const GlobalBinding *FindGlobal(const String &name) const;
+
+    /*! \brief Returns nullptr if the program was not compiled with a class of that name. */
+    const ClassBinding *FindClass(const String &name) const;
+
+    /*! \brief The number of slots VMState::m_native_functions needs. */
+    SizeType GetNumNativeFunctions() const;
+
+private:
+    Array<GlobalBinding>    m_globals;
+    Array<ClassBinding>     m_classes;
+};
+
+} // namespace vm
+} // namespace hyperion
+
+#endif
@@ -11,32 +11,43 @@ BytecodeStream BytecodeStream::FromSourceFile(SourceFile &file)
 }
 
 BytecodeStream::BytecodeStream()
-    : m_position(0)
+    : m_data(nullptr),
+      m_size(0),
+      m_position(0)
 {
 }
 
 BytecodeStream::BytecodeStream(const UByte *buffer, SizeType size, SizeType position)
-    : m_byte_buffer(size, buffer),
-      m_position(position)
+    : BytecodeStream(ByteBuffer(size, buffer), position)
 {
 }
 
 BytecodeStream::BytecodeStream(const ByteBuffer &byte_buffer, SizeType position)
-    : m_byte_buffer(byte_buffer),
+    : BytecodeStream(RC<Program>(new Program(byte_buffer, 0, { })), position)
+{
+}
+
+BytecodeStream::BytecodeStream(const RC<Program> &program, SizeType position)
+    : m_program(program),
+      m_data(program != nullptr ? program->GetCodeData() : nullptr),
+      m_size(program != nullptr ? program->GetCodeSize() : 0),
       m_position(position)
 {
-    
 }
 
 BytecodeStream::BytecodeStream(const BytecodeStream &other)
-    : m_byte_buffer(other.m_byte_buffer),
+    : m_program(other.m_program),
+      m_data(other.m_data),
+      m_size(other.m_size),
       m_position(other.m_position)
 {
 }
 
 BytecodeStream &BytecodeStream::operator=(const BytecodeStream &other)
 {
-    m_byte_buffer = other.m_byte_buffer;
+    m_program = other.m_program;
+    m_data = other.m_data;
+    m_size = other.m_size;
     m_position = other.m_position;
 
     return *this;
@@ -47,12 +58,10 @@ void BytecodeStream::ReadZeroTerminatedString(SChar *ptr)
     UByte ch;
     SizeType i = 0;
 
-    const auto *data = m_byte_buffer.Data();
-
     do {
-        AssertThrowMsg(m_position < m_byte_buffer.Size(), "Attempted to read past end of buffer!");
+        AssertThrowMsg(m_position < m_size, "Attempted to read past end of buffer!");
 
-        ptr[i++] = SChar(ch = data[m_position++]);
+        ptr[i++] = SChar(ch = m_data[m_position++]);
     } while (ch);
 }
 
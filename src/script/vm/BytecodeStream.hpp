@@ -2,8 +2,11 @@
 #define BYTECODE_STREAM_HPP
 
 #include <script/SourceFile.hpp>
+#include <script/vm/Program.hpp>
 #include <system/Debug.hpp>
 #include <core/lib/ByteBuffer.hpp>
+#include <core/lib/RefCountedPtr.hpp>
+#include <core/lib/CMemory.hpp>
 
 #include <Types.hpp>
 
@@ -19,23 +22,25 @@ public:
     BytecodeStream();
     BytecodeStream(const UByte *buffer, SizeType size, SizeType position = 0);
     BytecodeStream(const ByteBuffer &byte_buffer, SizeType position = 0);
+    /*! \brief Read from a shared Program without copying its code. */
+    BytecodeStream(const RC<Program> &program, SizeType position = 0);
     BytecodeStream(const BytecodeStream &other);
     ~BytecodeStream() = default;
 
     BytecodeStream &operator=(const BytecodeStream &other);
 
+    const RC<Program> &GetProgram() const
+        { return m_program; }
+
     const UByte *GetBuffer() const
-        { return m_byte_buffer.Data(); }
+        { return m_data; }
 
     void ReadBytes(UByte *ptr, SizeType num_bytes)
     {
-        AssertThrowMsg(m_position + num_bytes < m_byte_buffer.Size() + 1, "cannot read past end of buffer");
-        
-        const auto *data = m_byte_buffer.Data();
+        AssertThrowMsg(m_position + num_bytes < m_size + 1, "cannot read past end of buffer");
 
-        for (SizeType i = 0; i < num_bytes; i++) {
-            ptr[i] = data[m_position++];
-        }
+        Memory::MemCpy(ptr, m_data + m_position, num_bytes);
+        m_position += num_bytes;
     }
 
     template <class T>
@@ -49,7 +54,7 @@ public:
         { m_position = position; }
 
     SizeType Size() const
-        { return m_byte_buffer.Size(); }
+        { return m_size; }
 
     void Seek(SizeType address)
         { m_position = address; }
@@ -58,13 +63,15 @@ public:
         { m_position += amount; }
 
     bool Eof() const
-        { return m_position >= m_byte_buffer.Size(); }
+        { return m_position >= m_size; }
 
     void ReadZeroTerminatedString(SChar *ptr);
 
 private:
-    ByteBuffer  m_byte_buffer;
-    SizeType    m_position;
+    RC<Program>     m_program;
+    const UByte     *m_data;
+    SizeType        m_size;
+    SizeType        m_position;
 };
 
 } // namespace vm
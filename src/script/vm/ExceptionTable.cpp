@@ -0,0 +1,41 @@
+#include <script/vm/ExceptionTable.hpp>
+
+namespace hyperion {
+namespace vm {
+
+ExceptionTable::ExceptionTable(Array<ExceptionTableEntry> entries)
+    : m_entries(std::move(entries))
+{
+}
+
+const ExceptionTableEntry *ExceptionTable::FindHandler(BCAddress address) const
+{
+    // find the first entry that begins at or after the address
+    SizeType first = 0;
+    SizeType last = m_entries.Size();
+
+    while (first < last) {
+        const SizeType middle = first + (last - first) / 2;
+
+        if (m_entries[middle].begin < address) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    // nested try blocks begin after the ones enclosing them,
+    // so the innermost covering block is the closest one before it
+    for (SizeType index = first; index != 0; index--) {
+        const ExceptionTableEntry &entry = m_entries[index - 1];
+
+        if (address <= entry.end) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace vm
+} // namespace hyperion
@@ -0,0 +1,54 @@
+#ifndef EXCEPTION_TABLE_HPP
+#define EXCEPTION_TABLE_HPP
+
+#include <core/lib/DynArray.hpp>
+#include <script/vm/Value.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion {
+namespace vm {
+
+/*! \brief The bytecode range covered by a single try block. */
+struct ExceptionTableEntry
+{
+    BCAddress   begin;          // address of the first instruction in the try block
+    BCAddress   end;            // address following the last instruction in the try block
+    BCAddress   catch_address;
+    // number of values above the start of the enclosing function's frame
+    // (or the bottom of the stack, for top level code) when the try block is entered
+    UInt32      stack_depth;
+};
+
+/*! \brief Maps bytecode addresses to the try blocks covering them, so that
+    entering or leaving a try block costs nothing at runtime. The table is
+    only consulted once an exception has been thrown. */
+class ExceptionTable
+{
+public:
+    ExceptionTable() = default;
+    /*! \brief Entries must be sorted by their begin address. Try blocks may
+        be nested, but may not otherwise overlap. */
+    ExceptionTable(Array<ExceptionTableEntry> entries);
+    ExceptionTable(const ExceptionTable &other)                 = default;
+    ExceptionTable &operator=(const ExceptionTable &other)      = default;
+    ExceptionTable(ExceptionTable &&other) noexcept             = default;
+    ExceptionTable &operator=(ExceptionTable &&other) noexcept  = default;
+    ~ExceptionTable()                                           = default;
+
+    const Array<ExceptionTableEntry> &GetEntries() const
+        { return m_entries; }
+
+    /*! \brief Find the innermost try block that covers the instruction ending at
+        \ref address, i.e. the address the stream is at after the instruction
+        that threw (or the return address of a call). Returns nullptr if there is none. */
+    const ExceptionTableEntry *FindHandler(BCAddress address) const;
+
+private:
+    Array<ExceptionTableEntry>  m_entries;
+};
+
+} // namespace vm
+} // namespace hyperion
+
+#endif
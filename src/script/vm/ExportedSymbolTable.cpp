@@ -41,6 +41,11 @@ auto ExportedSymbolTable::Store(HashFNV1 hash, const Value &value) -> typename S
     return m_symbols.Insert(hash, value);
 }
 
+void ExportedSymbolTable::Clear()
+{
+    m_symbols.Clear();
+}
+
 
 } // namespace vm
 } // namespace hyperion
@@ -28,6 +28,9 @@ public:
     typename SymbolMap::InsertResult Store(const char *name, const Value &value);
     typename SymbolMap::InsertResult Store(HashFNV1 hash, const Value &value);
 
+    /*! \brief Remove all symbols, so that a reloaded program can export them again. */
+    void Clear();
+
 private:
     SymbolMap m_symbols;
 };
@@ -4,6 +4,7 @@
 #include <script/vm/VMArraySlice.hpp>
 #include <script/vm/VMString.hpp>
 #include <script/vm/VMMap.hpp>
+#include <script/vm/VMGenerator.hpp>
 
 #include <iostream>
 
@@ -54,6 +55,10 @@ void HeapValue::Mark()
             pair.first.key.Mark();
             pair.second.Mark();
         }
+    } else if (VMGenerator *generator = GetPointer<VMGenerator>()) {
+        for (Value &value : generator->GetFrame()) {
+            value.Mark();
+        }
     }
 }
 
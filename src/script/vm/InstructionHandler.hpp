@@ -8,6 +8,7 @@
 #include <script/vm/Value.hpp>
 #include <script/vm/HeapValue.hpp>
 #include <script/vm/VMArray.hpp>
+#include <script/vm/VMGenerator.hpp>
 #include <script/vm/VMMemoryBuffer.hpp>
 #include <script/vm/VMObject.hpp>
 #include <script/vm/VMString.hpp>
@@ -335,7 +336,8 @@ public:
 
     HYP_FORCE_INLINE void LoadOffset(BCRegister reg, UInt16 offset)
     {
-        const auto &stk = state->MAIN_THREAD->m_stack;
+        // offsets are relative to the stack of the thread executing the code
+        const auto &stk = thread->m_stack;
 
         AssertThrowMsg(
             offset <= stk.GetStackPointer(),
@@ -345,7 +347,7 @@ public:
 
         // read value from stack at (sp - offset)
         // into the the register
-        thread->m_regs[reg].AssignValue(thread->m_stack[thread->m_stack.GetStackPointer() - offset], false);
+        thread->m_regs[reg].AssignValue(stk[stk.GetStackPointer() - offset], false);
     }
 
     HYP_FORCE_INLINE void LoadIndex(BCRegister reg, UInt16 index)
@@ -360,7 +362,8 @@ public:
         );
 
         // read value from stack at the index into the the register
-        // NOTE: read from main thread
+        // NOTE: read from main thread, which holds the globals for every thread.
+        // nothing synchronizes this with writes from other threads.
         thread->m_regs[reg].AssignValue(stk[index], false);
     }
 
@@ -652,8 +655,59 @@ public:
         }
     }
 
+    /*! \brief Get the array held in a register for an unchecked access - either the array itself,
+        or an Array object holding it in its __intern member. Returns null (after throwing) if neither. */
+    HYP_FORCE_INLINE VMArray *GetUncheckedArray(BCRegister reg)
+    {
+        const Value &sv = thread->m_regs[reg];
+
+        if (sv.m_type == Value::HEAP_POINTER && sv.m_value.ptr != nullptr) {
+            if (VMArray *array = sv.m_value.ptr->GetPointer<VMArray>()) {
+                return array;
+            }
+
+            if (VMObject *object = sv.m_value.ptr->GetPointer<VMObject>()) {
+                if (Member *member = object->LookupMemberFromHash(VMObject::INTERN_MEMBER_HASH, false)) {
+                    const Value &intern = member->value;
+
+                    if (intern.m_type == Value::HEAP_POINTER && intern.m_value.ptr != nullptr) {
+                        if (VMArray *array = intern.m_value.ptr->GetPointer<VMArray>()) {
+                            return array;
+                        }
+                    }
+                }
+            }
+        }
+
+        state->ThrowException(
+            thread,
+            Exception("Not an Array")
+        );
+
+        return nullptr;
+    }
+
+    /*! \brief Load an array element the compiler has proven to be in range: the index is a
+        non-negative Int32 less than the array's size, so it is not converted or bounds checked. */
+    HYP_FORCE_INLINE void LoadArrayIdxUnchecked(BCRegister dst_reg, BCRegister src_reg, BCRegister index_reg)
+    {
+        VMArray *array = GetUncheckedArray(src_reg);
+
+        if (array == nullptr) {
+            return;
+        }
+
+        thread->m_regs[dst_reg].AssignValue(array->AtIndex(SizeType(thread->m_regs[index_reg].m_value.i32)), false);
+    }
+
     HYP_FORCE_INLINE void LoadOffsetRef(BCRegister reg, UInt16 offset)
     {
+        AssertThrowMsg(
+            offset <= thread->m_stack.GetStackPointer(),
+            "Stack offset out of bounds (%u)",
+            offset
+        );
+
         thread->m_regs[reg] = Value(
             Value::ValueType::VALUE_REF,
             Value::ValueData { .value_ref = &thread->m_stack[thread->m_stack.GetStackPointer() - offset] }
@@ -662,6 +716,8 @@ public:
 
     HYP_FORCE_INLINE void LoadIndexRef(BCRegister reg, UInt16 index)
     {
+        // indices address globals, which live on the main thread's stack
+        // whichever thread is executing
         auto &stk = state->MAIN_THREAD->m_stack;
 
         AssertThrowMsg(
@@ -725,13 +781,23 @@ public:
 
     HYP_FORCE_INLINE void MovIndex(UInt16 index, BCRegister reg)
     {
-        // copy value from register to stack value at index
-        state->MAIN_THREAD->m_stack[index].AssignValue(thread->m_regs[reg], true);
+        auto &stk = state->MAIN_THREAD->m_stack;
+
+        AssertThrowMsg(
+            index < stk.GetStackPointer(),
+            "Stack index out of bounds (%u >= %llu)",
+            index,
+            stk.GetStackPointer()
+        );
+
+        // copy value from register to stack value at index.
+        // globals are shared by every thread, and writes to them are not synchronized.
+        stk[index].AssignValue(thread->m_regs[reg], true);
     }
 
     HYP_FORCE_INLINE void MovStatic(UInt16 index, BCRegister reg)
     {
-        AssertThrow(index < state->m_static_memory.static_size);
+        AssertThrow(index < state->m_static_memory.GetSize());
 
         // ensure we will not be overwriting something that is marked ALWAYS_ALIVE
         // will cause a memory leak if we overwrite it, or if we did change the flag,
@@ -1131,6 +1197,20 @@ public:
         }
     }
 
+    /*! \brief Store to an array element the compiler has proven to be in range. See LoadArrayIdxUnchecked. */
+    HYP_FORCE_INLINE void MovArrayIdxUnchecked(BCRegister dst_reg, BCRegister index_reg, BCRegister src_reg)
+    {
+        VMArray *array = GetUncheckedArray(dst_reg);
+
+        if (array == nullptr) {
+            return;
+        }
+
+        Value &element = array->AtIndex(SizeType(thread->m_regs[index_reg].m_value.i32));
+        element = thread->m_regs[src_reg];
+        element.Mark();
+    }
+
     HYP_FORCE_INLINE void MovReg(BCRegister dst_reg, BCRegister src_reg)
     {
         thread->m_regs[dst_reg] = thread->m_regs[src_reg];
@@ -1245,11 +1325,79 @@ public:
         state->m_vm->Invoke(this, thread->m_regs[reg], nargs);
     }
 
+    HYP_FORCE_INLINE void CallNative(UInt16 index, UInt8 nargs)
+    {
+        AssertThrowMsg(index < state->m_native_functions.Size(), "Native function %u has not been bound", index);
+
+        state->m_vm->InvokeNative(this, state->m_native_functions[index], nargs);
+    }
+
+    HYP_FORCE_INLINE void TailCall(BCRegister reg, UInt8 nargs, UInt8 frame_nargs, UInt16 frame_locals)
+    {
+        const Value value = thread->m_regs[reg];
+
+        StackMemory &stack = thread->GetStack();
+
+        // the current frame is laid out as:
+        //  [args (frame_nargs)] [FUNCTION_CALL] [locals (frame_locals)] [new args (nargs)]
+        const SizeType args_start = stack.GetStackPointer() - nargs;
+        const SizeType call_index = args_start - frame_locals - 1;
+
+        const Bool can_reuse_frame = value.m_type == Value::FUNCTION
+            && !(value.m_value.func.m_flags & (FunctionFlags::VARIADIC | FunctionFlags::GENERATOR))
+            && value.m_value.func.m_nargs == nargs
+            && thread->m_func_depth != 0
+            && !(thread->m_generator_frames.Any() && thread->m_generator_frames.Back().call_index == call_index);
+
+        if (!can_reuse_frame) {
+            // natives, closures, variadic functions etc. are called normally
+            state->m_vm->Invoke(this, value, nargs);
+
+            return;
+        }
+
+        AssertThrow(call_index >= frame_nargs);
+        AssertThrow(stack[call_index].m_type == Value::FUNCTION_CALL);
+
+        Value call = stack[call_index];
+
+        // where the stack pointer must end up once the callee returns to our caller
+        const SizeType return_sp = SizeType(Int64(call_index) + call.m_value.call.varargs_push);
+
+        // move the new arguments down over the current frame
+        const SizeType frame_start = call_index - frame_nargs;
+
+        for (SizeType index = 0; index < nargs; index++) {
+            stack[frame_start + index] = stack[args_start + index];
+        }
+
+        const SizeType new_call_index = frame_start + nargs;
+
+        call.m_value.call.varargs_push = Int32(Int64(return_sp) - Int64(new_call_index));
+        stack[new_call_index] = call;
+        stack.m_sp = new_call_index + 1;
+
+        // function depth is unchanged, as the current function is replaced
+        bs->Seek(value.m_value.func.m_addr);
+    }
+
     HYP_FORCE_INLINE void Ret()
     {
         // get top of stack (should be the address before jumping)
         Value &top = thread->GetStack().Top();
         AssertThrow(top.GetType() == Value::FUNCTION_CALL);
+
+        if (thread->m_generator_frames.Any() && thread->m_generator_frames.Back().call_index == thread->GetStack().GetStackPointer() - 1) {
+            // returning from a resumed generator, it is now finished
+            VMGenerator *generator = thread->m_generator_frames.Back().generator->GetPointer<VMGenerator>();
+            AssertThrow(generator != nullptr);
+
+            generator->SetIsRunning(false);
+            generator->SetIsDone(true);
+            generator->GetFrame().Clear();
+
+            thread->m_generator_frames.PopBack();
+        }
         
         // leave function and return to previous position
         bs->Seek(top.GetValue().call.return_address);
@@ -1263,28 +1411,53 @@ public:
         thread->m_func_depth--;
     }
 
-    HYP_FORCE_INLINE void BeginTry(BCAddress addr)
+    HYP_FORCE_INLINE void Yield(BCRegister reg)
     {
-        ++thread->m_exception_state.m_try_counter;
+        StackMemory &stack = thread->GetStack();
+
+        if (thread->m_generator_frames.Empty() || thread->m_generator_frames.Back().call_index >= stack.GetStackPointer()) {
+            state->ThrowException(
+                thread,
+                Exception("yield outside of a running generator")
+            );
 
-        // increase stack size to store data about this try block
-        Value info;
-        info.m_type = Value::TRY_CATCH_INFO;
-        info.m_value.try_catch_info.catch_address = addr;
+            return;
+        }
 
-        // store the info
-        thread->m_stack.Push(info);
-    }
+        const GeneratorFrame frame = thread->m_generator_frames.PopBack();
 
-    HYP_FORCE_INLINE void EndTry()
-    {
-        // pop the try catch info from the stack
-        AssertThrow(thread->m_stack.Top().m_type == Value::TRY_CATCH_INFO);
-        AssertThrow(thread->m_exception_state.m_try_counter != 0);
+        VMGenerator *generator = frame.generator->GetPointer<VMGenerator>();
+        AssertThrow(generator != nullptr);
 
-        // pop try catch info
-        thread->m_stack.Pop();
-        --thread->m_exception_state.m_try_counter;
+        const Value &call = stack[frame.call_index];
+        AssertThrow(call.m_type == Value::FUNCTION_CALL);
+
+        // the generator's frame is laid out as:
+        //  [generator] [args...] [FUNCTION_CALL] [locals...]
+        const SizeType args_start = frame.call_index - generator->GetNumArgs();
+        AssertThrow(args_start != 0);
+
+        Array<Value> &saved_frame = generator->GetFrame();
+        saved_frame.Clear();
+
+        for (SizeType index = args_start; index < frame.call_index; index++) {
+            saved_frame.PushBack(stack[index]);
+        }
+
+        for (SizeType index = frame.call_index + 1; index < stack.GetStackPointer(); index++) {
+            saved_frame.PushBack(stack[index]);
+        }
+
+        generator->SetResumeAddress(static_cast<BCAddress>(bs->Position()));
+        generator->SetIsRunning(false);
+
+        thread->m_regs[0] = thread->m_regs[reg];
+
+        // leave the generator as if it had returned, popping the generator object as well
+        bs->Seek(call.m_value.call.return_address);
+        stack.m_sp = args_start - 1;
+
+        thread->m_func_depth--;
     }
 
     HYP_FORCE_INLINE void New(BCRegister dst, BCRegister src)
@@ -0,0 +1,21 @@
+#include <script/vm/Program.hpp>
+
+namespace hyperion {
+namespace vm {
+
+Program::Program(
+    ByteBuffer code,
+    SizeType num_static_objects,
+    ExportedSymbolNames exported_symbol_names,
+    ExceptionTable exception_table,
+    BindingTable binding_table
+) : m_code(std::move(code)),
+    m_num_static_objects(num_static_objects),
+    m_exported_symbol_names(std::move(exported_symbol_names)),
+    m_exception_table(std::move(exception_table)),
+    m_binding_table(std::move(binding_table))
+{
+}
+
+} // namespace vm
+} // namespace hyperion
@@ -0,0 +1,81 @@
+#ifndef PROGRAM_HPP
+#define PROGRAM_HPP
+
+#include <core/lib/ByteBuffer.hpp>
+#include <core/lib/FlatMap.hpp>
+#include <core/lib/String.hpp>
+#include <core/lib/RefCountedPtr.hpp>
+
+#include <script/Hasher.hpp>
+#include <script/vm/ExceptionTable.hpp>
+#include <script/vm/BindingTable.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion {
+namespace vm {
+
+/*! \brief An immutable, baked script image.
+    \details A Program holds everything about a compiled script that does not change
+    while it runs: the bytecode, the ranges covered by try blocks, the number of
+    static memory slots its types occupy, the slots its native globals and classes
+    are bound into, and the names of the symbols it exports. It is shared by reference between any
+    number of BytecodeStreams (and therefore VMs), each of which only owns its own
+    read position. Stacks, heaps, registers and static memory stay per VMState.
+*/
+class Program
+{
+public:
+    using ExportedSymbolNames = FlatMap<HashFNV1, String>;
+
+    Program(
+        ByteBuffer code,
+        SizeType num_static_objects,
+        ExportedSymbolNames exported_symbol_names,
+        ExceptionTable exception_table = { },
+        BindingTable binding_table = { }
+    );
+
+    Program(const Program &other)                   = delete;
+    Program &operator=(const Program &other)        = delete;
+    Program(Program &&other) noexcept               = delete;
+    Program &operator=(Program &&other) noexcept    = delete;
+    ~Program()                                      = default;
+
+    const ByteBuffer &GetCode() const
+        { return m_code; }
+
+    const UByte *GetCodeData() const
+        { return m_code.Data(); }
+
+    SizeType GetCodeSize() const
+        { return m_code.Size(); }
+
+    const ExceptionTable &GetExceptionTable() const
+        { return m_exception_table; }
+
+    const BindingTable &GetBindingTable() const
+        { return m_binding_table; }
+
+    /*! \brief The number of static memory slots a VM needs to run this program. */
+    SizeType GetNumStaticObjects() const
+        { return m_num_static_objects; }
+
+    const ExportedSymbolNames &GetExportedSymbolNames() const
+        { return m_exported_symbol_names; }
+
+    bool HasExportedSymbol(HashFNV1 hash) const
+        { return m_exported_symbol_names.Contains(hash); }
+
+private:
+    ByteBuffer          m_code;
+    SizeType            m_num_static_objects;
+    ExportedSymbolNames m_exported_symbol_names;
+    ExceptionTable      m_exception_table;
+    BindingTable        m_binding_table;
+};
+
+} // namespace vm
+} // namespace hyperion
+
+#endif
@@ -1,15 +1,18 @@
 #include <script/vm/StaticMemory.hpp>
 #include <script/vm/HeapValue.hpp>
 
+#include <math/MathUtil.hpp>
+
 namespace hyperion {
 namespace vm {
 
 const UInt16 StaticMemory::static_size = 65535;
 
-StaticMemory::StaticMemory()
-    : m_data(new Value[static_size])
+StaticMemory::StaticMemory(SizeType size)
+    : m_data(nullptr),
+      m_size(0)
 {
-    Memory::MemSet(m_data, 0, static_size * sizeof(Value));
+    SetSize(size);
 }
 
 StaticMemory::~StaticMemory()
@@ -20,10 +23,43 @@ StaticMemory::~StaticMemory()
     delete[] m_data;
 }
 
+void StaticMemory::SetSize(SizeType size)
+{
+    AssertThrowMsg(size <= static_size, "Static memory size %llu exceeds maximum of %u", size, static_size);
+
+    if (size == m_size) {
+        return;
+    }
+
+    Value *data = size != 0 ? new Value[size] : nullptr;
+
+    if (size != 0) {
+        Memory::MemSet(data, 0, size * sizeof(Value));
+    }
+
+    // values past the new size are released to the gc
+    for (SizeType i = size; i < m_size; i++) {
+        Value &sv = m_data[i];
+
+        if (sv.m_type == Value::HEAP_POINTER && sv.m_value.ptr != nullptr) {
+            sv.m_value.ptr->DisableFlags(GC_ALWAYS_ALIVE);
+        }
+    }
+
+    if (m_data != nullptr) {
+        Memory::MemCpy(data, m_data, MathUtil::Min(size, m_size) * sizeof(Value));
+
+        delete[] m_data;
+    }
+
+    m_data = data;
+    m_size = size;
+}
+
 void StaticMemory::MarkAllForDeallocation()
 {
     // delete all objects that are heap allocated
-    for (UInt32 i = static_size; i != 0; i--) {
+    for (SizeType i = m_size; i != 0; i--) {
         Value &sv = m_data[i - 1];
 
         if (sv.m_type == Value::HEAP_POINTER && sv.m_value.ptr != nullptr) {
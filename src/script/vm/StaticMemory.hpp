@@ -16,10 +16,18 @@ public:
     static const UInt16 static_size;
 
 public:
-    StaticMemory();
+    StaticMemory(SizeType size = static_size);
     StaticMemory(const StaticMemory &other) = delete;
     ~StaticMemory();
 
+    SizeType GetSize() const
+        { return m_size; }
+
+    /*! \brief Resize the static memory to hold exactly \ref{size} values,
+        keeping any values already stored below the new size. Used to fit
+        static memory to the number of static objects a Program uses. */
+    void SetSize(SizeType size);
+
     /*! \brief Marks all values for deallocation, 
         allowing the garbage collector to free them. */
     void MarkAllForDeallocation();
@@ -27,19 +35,20 @@ public:
     HYP_FORCE_INLINE
     Value &operator[](SizeType index)
     {
-        AssertThrowMsg(index < static_size, "out of bounds");
+        AssertThrowMsg(index < m_size, "out of bounds");
         return m_data[index];
     }
     
     HYP_FORCE_INLINE
     const Value &operator[](SizeType index) const
     {
-        AssertThrowMsg(index < static_size, "out of bounds");
+        AssertThrowMsg(index < m_size, "out of bounds");
         return m_data[index];
     }
 
 private:
-    Value   *m_data;
+    Value       *m_data;
+    SizeType    m_size;
 };
 
 } // namespace vm
@@ -3,6 +3,7 @@
 #include <script/vm/HeapValue.hpp>
 #include <script/vm/VMArray.hpp>
 #include <script/vm/VMArraySlice.hpp>
+#include <script/vm/VMGenerator.hpp>
 #include <script/vm/VMObject.hpp>
 #include <script/vm/VMString.hpp>
 #include <script/vm/VMTypeInfo.hpp>
@@ -14,6 +15,7 @@
 #include <system/Debug.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cinttypes>
 #include <mutex>
@@ -336,6 +338,19 @@ HYP_FORCE_INLINE static void HandleInstruction(
 
         break;
     }
+    case LOAD_ARRAYIDX_UNCHECKED: {
+        BCRegister dst_reg; bs->Read(&dst_reg);
+        BCRegister src_reg; bs->Read(&src_reg);
+        BCRegister index_reg; bs->Read(&index_reg);
+
+        handler.LoadArrayIdxUnchecked(
+            dst_reg,
+            src_reg,
+            index_reg
+        );
+
+        break;
+    }
     case LOAD_OFFSET_REF: {
         BCRegister reg; bs->Read(&reg);
         UInt16 offset; bs->Read(&offset);
@@ -498,6 +513,19 @@ HYP_FORCE_INLINE static void HandleInstruction(
 
         break;
     }
+    case MOV_ARRAYIDX_UNCHECKED: {
+        BCRegister dst; bs->Read(&dst);
+        BCRegister index_reg; bs->Read(&index_reg);
+        BCRegister src; bs->Read(&src);
+
+        handler.MovArrayIdxUnchecked(
+            dst,
+            index_reg,
+            src
+        );
+
+        break;
+    }
     case MOV_REG: {
         BCRegister dst; bs->Read(&dst);
         BCRegister src; bs->Read(&src);
@@ -632,18 +660,29 @@ HYP_FORCE_INLINE static void HandleInstruction(
         
         break;
     }
-    case BEGIN_TRY: {
-        BCAddress catch_address;
-        bs->Read(&catch_address);
+    case CALL_NATIVE: {
+        UInt16 index; bs->Read(&index);
+        UInt8 nargs; bs->Read(&nargs);
 
-        handler.BeginTry(
-            catch_address
+        handler.CallNative(
+            index,
+            nargs
         );
 
         break;
     }
-    case END_TRY: {
-        handler.EndTry();
+    case TAIL_CALL: {
+        BCRegister reg; bs->Read(&reg);
+        UInt8 nargs; bs->Read(&nargs);
+        UInt8 frame_nargs; bs->Read(&frame_nargs);
+        UInt16 frame_locals; bs->Read(&frame_locals);
+
+        handler.TailCall(
+            reg,
+            nargs,
+            frame_nargs,
+            frame_locals
+        );
 
         break;
     }
@@ -1027,6 +1066,15 @@ HYP_FORCE_INLINE static void HandleInstruction(
 
         break;
     }
+    case YIELD: {
+        BCRegister src; bs->Read(&src);
+
+        handler.Yield(
+            src
+        );
+
+        break;
+    }
     default: {
         Int64 last_pos = Int64(bs->Position()) - sizeof(UByte);
         utf::printf(HYP_UTF8_CSTR("unknown instruction '%d' referenced at location: 0x%" PRIx64 "\n"), code, last_pos);
@@ -1038,8 +1086,38 @@ HYP_FORCE_INLINE static void HandleInstruction(
     }
 }
 
-VM::VM(APIInstance &api_instance)
-    : m_api_instance(api_instance)
+// marks the thread as executing bytecode for the duration of the scope,
+// so that garbage collections wait for it to reach a safepoint
+struct ExecutionScope
+{
+    VMState         &state;
+    ExecutionThread *thread;
+    Bool            previous_can_park;
+
+    ExecutionScope(VMState &state, ExecutionThread *thread, Bool can_park = false)
+        : state(state),
+          thread(thread),
+          previous_can_park(thread->m_can_park)
+    {
+        state.EnterExecution(thread);
+
+        thread->m_can_park = can_park;
+    }
+
+    ExecutionScope(const ExecutionScope &other) = delete;
+    ExecutionScope &operator=(const ExecutionScope &other) = delete;
+
+    ~ExecutionScope()
+    {
+        thread->m_can_park = previous_can_park;
+
+        state.LeaveExecution(thread);
+    }
+};
+
+VM::VM(APIInstance &api_instance, SizeType num_static_objects)
+    : m_api_instance(api_instance),
+      m_state(num_static_objects)
 {
     m_state.m_vm = non_owning_ptr<VM>(this);
     // create main thread
@@ -1060,6 +1138,46 @@ void VM::PushNativeFunctionPtr(NativeFunctionPtr_t ptr)
     m_state.GetMainThread()->m_stack.Push(sv);
 }
 
+void VM::InvokeNative(
+    InstructionHandler *handler,
+    NativeFunctionPtr_t native_func,
+    UInt8 nargs
+)
+{
+    VMState *state = handler->state;
+    ExecutionThread *thread = handler->thread;
+
+    AssertThrow(native_func != nullptr);
+
+    // nargs fits in a byte, so the argument pointers can live on the native stack
+    Value *args[256];
+
+    Int64 i = static_cast<Int64>(thread->m_stack.GetStackPointer()) - 1;
+    for (int j = nargs - 1; j >= 0 && i >= 0; i--, j--) {
+        args[j] = &thread->m_stack[i];
+    }
+
+    sdk::Params params {
+        .api_instance   = m_api_instance,
+        .handler        = handler,
+        .args           = args,
+        .nargs          = nargs
+    };
+
+    // no collections happen during a native function
+    state->BeginNativeCall();
+
+    // call the native function
+    native_func(params);
+
+    state->EndNativeCall();
+
+    if (thread->m_async_result != nullptr && !thread->m_can_park) {
+        // the caller can't be parked, so block until the result arrives
+        WaitForAsyncResult(thread);
+    }
+}
+
 void VM::Invoke(
     InstructionHandler *handler,
     const Value &value,
@@ -1078,30 +1196,7 @@ void VM::Invoke(
 
     if (value.m_type != Value::FUNCTION) {
         if (value.m_type == Value::NATIVE_FUNCTION) {
-            Value **args = new Value*[nargs > 0 ? nargs : 1];
-
-            Int64 i = static_cast<Int64>(thread->m_stack.GetStackPointer()) - 1;
-            for (int j = nargs - 1; j >= 0 && i >= 0; i--, j--) {
-                args[j] = &thread->m_stack[i];
-            }
-
-            sdk::Params params {
-                .api_instance   = m_api_instance,
-                .handler        = handler,
-                .args           = args,
-                .nargs          = nargs
-            };
-
-            // disable auto gc so no collections happen during a native function
-            state->enable_auto_gc = false;
-
-            // call the native function
-            value.m_value.native_func(params);
-
-            // re-enable auto gc
-            state->enable_auto_gc = ENABLE_GC;
-
-            delete[] args;
+            InvokeNative(handler, value.m_value.native_func, nargs);
 
             return;
         } else if (value.m_type == Value::HEAP_POINTER) {
@@ -1110,6 +1205,14 @@ void VM::Invoke(
                     thread,
                     Exception::NullReferenceException()
                 );
+                return;
+            } else if (VMGenerator *generator = value.m_value.ptr->GetPointer<VMGenerator>()) {
+                ResumeGenerator(
+                    handler,
+                    value.m_value.ptr,
+                    nargs
+                );
+
                 return;
             } else if (VMObject *object = value.m_value.ptr->GetPointer<VMObject>()) {
                 if (Member *member = object->LookupMemberFromHash(invoke_hash)) {
@@ -1131,12 +1234,21 @@ void VM::Invoke(
                         thread->m_stack.Push(value);
                     }
 
+                    const UInt func_depth_before = thread->m_func_depth;
+
                     Invoke(
                         handler,
                         member->value,
                         nargs + 1
                     );
 
+                    if (thread->m_func_depth == func_depth_before) {
+                        // no frame was pushed (e.g a generator was created), so drop the extra 'self' slot here
+                        thread->m_stack.Pop();
+
+                        return;
+                    }
+
                     Value &top = thread->m_stack.Top();
                     AssertThrow(top.m_type == Value::FUNCTION_CALL);
 
@@ -1183,6 +1295,12 @@ void VM::Invoke(
                 nargs
             )
         );
+    } else if (value.m_value.func.m_flags & FunctionFlags::GENERATOR) {
+        CreateGenerator(
+            handler,
+            value,
+            nargs
+        );
     } else {
         Value previous_addr;
         previous_addr.m_type = Value::FUNCTION_CALL;
@@ -1236,13 +1354,147 @@ void VM::Invoke(
     }
 }
 
+void VM::CreateGenerator(
+    InstructionHandler *handler,
+    const Value &value,
+    UInt8 nargs
+)
+{
+    VMState *state = handler->state;
+    ExecutionThread *thread = handler->thread;
+
+    AssertThrow(value.m_type == Value::FUNCTION);
+
+    if (value.m_value.func.m_flags & FunctionFlags::VARIADIC) {
+        state->ThrowException(
+            thread,
+            Exception("variadic generator functions are not supported")
+        );
+
+        return;
+    }
+
+    VMGenerator generator(value.m_value.func.m_addr, nargs);
+
+    // the arguments become the start of the generator's saved frame
+    const SizeType sp = thread->m_stack.GetStackPointer();
+    AssertThrow(sp >= nargs);
+
+    for (SizeType index = sp - nargs; index < sp; index++) {
+        generator.GetFrame().PushBack(thread->m_stack[index]);
+    }
+
+    HeapValue *hv = state->HeapAlloc(thread);
+
+    if (hv == nullptr) {
+        return;
+    }
+
+    hv->Assign(std::move(generator));
+
+    thread->m_regs[0].m_type = Value::HEAP_POINTER;
+    thread->m_regs[0].m_value.ptr = hv;
+}
+
+void VM::ResumeGenerator(
+    InstructionHandler *handler,
+    HeapValue *generator_ptr,
+    UInt8 nargs
+)
+{
+    VMState *state = handler->state;
+    ExecutionThread *thread = handler->thread;
+    BytecodeStream *bs = handler->bs;
+
+    VMGenerator *generator = generator_ptr->GetPointer<VMGenerator>();
+    AssertThrow(generator != nullptr);
+
+    if (nargs != 0) {
+        state->ThrowException(
+            thread,
+            Exception::InvalidArgsException(0, nargs)
+        );
+
+        return;
+    }
+
+    if (generator->IsRunning()) {
+        state->ThrowException(
+            thread,
+            Exception("generator is already running")
+        );
+
+        return;
+    }
+
+    if (generator->IsDone()) {
+        // a finished generator yields null
+        thread->m_regs[0].m_type = Value::HEAP_POINTER;
+        thread->m_regs[0].m_value.ptr = nullptr;
+
+        return;
+    }
+
+    const Array<Value> &saved_frame = generator->GetFrame();
+    const SizeType num_args = generator->GetNumArgs();
+
+    AssertThrow(saved_frame.Size() >= num_args);
+
+    // keep the generator on the stack below its arguments, so it stays alive while running
+    Value generator_value;
+    generator_value.m_type = Value::HEAP_POINTER;
+    generator_value.m_value.ptr = generator_ptr;
+
+    thread->m_stack.Push(generator_value);
+
+    for (SizeType index = 0; index < num_args; index++) {
+        thread->m_stack.Push(saved_frame[index]);
+    }
+
+    // returning pops the arguments and the generator as well,
+    // as the caller only pushed (and will pop) nargs values
+    Value previous_addr;
+    previous_addr.m_type = Value::FUNCTION_CALL;
+    previous_addr.m_value.call.return_address = static_cast<BCAddress>(bs->Position());
+    previous_addr.m_value.call.varargs_push = -Int32(num_args + 1);
+
+    thread->m_stack.Push(previous_addr);
+
+    thread->m_generator_frames.PushBack(GeneratorFrame {
+        generator_ptr,
+        thread->m_stack.GetStackPointer() - 1
+    });
+
+    for (SizeType index = num_args; index < saved_frame.Size(); index++) {
+        thread->m_stack.Push(saved_frame[index]);
+    }
+
+    generator->SetIsRunning(true);
+
+    bs->Seek(generator->GetResumeAddress());
+
+    thread->m_func_depth++;
+}
+
 void VM::InvokeNow(
     BytecodeStream *bs,
     const Value &value,
     UInt8 nargs
 )
 {
-    ExecutionThread *thread = m_state.MAIN_THREAD;
+    InvokeNow(bs, value, nargs, m_state.MAIN_THREAD);
+}
+
+void VM::InvokeNow(
+    BytecodeStream *bs,
+    const Value &value,
+    UInt8 nargs,
+    ExecutionThread *thread
+)
+{
+    AssertThrow(thread != nullptr);
+
+    ExecutionScope execution_scope(m_state, thread);
     
     const SizeType position_before = bs->Position();
     const UInt original_function_depth = thread->m_func_depth;
@@ -1260,38 +1512,163 @@ void VM::InvokeNow(
         nargs
     );
 
-    if (value.m_type == Value::FUNCTION) { // don't do this for native function calls
-        UByte code;
+    if (thread->m_func_depth != original_function_depth) { // don't do this for native function calls
+        RunUntilReturn(
+            &handler,
+            original_function_depth,
+            stack_size_before
+        );
+    }
+    
+    bs->SetPosition(position_before);
+}
 
-        while (!bs->Eof()) {
-            bs->Read(&code);
-            
-            HandleInstruction(
-                handler,
-                bs,
-                code
-            );
-
-            if (handler.thread->GetExceptionState().HasExceptionOccurred()) {
-                if (!HandleException(&handler)) {
-                    thread->m_exception_state.m_exception_depth = 0;
+SizeType VM::InvokeBatch(
+    BytecodeStream *bs,
+    const Value &value,
+    UInt8 nargs,
+    const Value *args,
+    SizeType count,
+    Value *results_out,
+    ExecutionThread *thread,
+    Continuation *out_parked
+)
+{
+    AssertThrow(thread != nullptr);
+    AssertThrow(nargs == 0 || args != nullptr);
 
-                    AssertThrow(thread->GetStack().GetStackPointer() >= stack_size_before);
-                    thread->GetStack().Pop(thread->GetStack().GetStackPointer() - stack_size_before);
+    ExecutionScope execution_scope(m_state, thread, out_parked != nullptr);
 
-                    break;
-                }
-            }
+    const SizeType position_before = bs->Position();
+    const UInt original_function_depth = thread->m_func_depth;
+    const SizeType stack_size_before = thread->GetStack().GetStackPointer();
 
-            if (code == RET) {
-                if (thread->m_func_depth == original_function_depth) {
-                    break;
-                }
+    InstructionHandler handler(
+        &m_state,
+        thread,
+        bs
+    );
+
+    for (SizeType call_index = 0; call_index < count; call_index++) {
+        const Value *call_args = args + call_index * nargs;
+
+        for (UInt8 i = 0; i < nargs; i++) {
+            thread->GetStack().Push(call_args[i]);
+        }
+
+        Invoke(
+            &handler,
+            value,
+            nargs
+        );
+
+        if (thread->m_func_depth != original_function_depth) { // don't do this for native function calls
+            if (!RunUntilReturn(
+                &handler,
+                original_function_depth,
+                stack_size_before + nargs
+            )) {
+                // parked on an async native call; the caller resumes the rest of this call
+                *out_parked = Continuation {
+                    .thread                     = thread,
+                    .position                   = bs->Position(),
+                    .original_function_depth    = original_function_depth,
+                    .stack_size_before          = stack_size_before,
+                    .run_to_eof                 = false,
+                    .is_done                    = false
+                };
+
+                bs->SetPosition(position_before);
+
+                return call_index;
             }
+        } else if (thread->m_async_result != nullptr) {
+            // there is no frame to park when the host calls an async native directly
+            WaitForAsyncResult(thread);
+        }
+
+        if (results_out != nullptr) {
+            results_out[call_index] = thread->m_regs[0];
         }
+
+        // pop the arguments for this call
+        thread->GetStack().Pop(thread->GetStack().GetStackPointer() - stack_size_before);
     }
-    
+
     bs->SetPosition(position_before);
+
+    return count;
+}
+
+bool VM::RunUntilReturn(
+    InstructionHandler *handler,
+    UInt original_function_depth,
+    SizeType stack_size_before
+)
+{
+    ExecutionThread *thread = handler->thread;
+    BytecodeStream *bs = handler->bs;
+
+    UByte code;
+
+    while (!bs->Eof()) {
+        bs->Read(&code);
+        
+        HandleInstruction(
+            *handler,
+            bs,
+            code
+        );
+
+        if (thread->GetExceptionState().HasExceptionOccurred()) {
+            if (!HandleException(handler, original_function_depth, false)) {
+                thread->m_exception_state.m_exception_depth = 0;
+                thread->m_func_depth = original_function_depth;
+
+                AssertThrow(thread->GetStack().GetStackPointer() >= stack_size_before);
+                thread->GetStack().Pop(thread->GetStack().GetStackPointer() - stack_size_before);
+
+                thread->UnwindGeneratorFrames();
+
+                break;
+            }
+        }
+
+        if (code == RET) {
+            if (thread->m_func_depth == original_function_depth) {
+                break;
+            }
+        }
+
+        // only set here if the thread can be parked; otherwise the native call has already waited
+        if (thread->m_async_result != nullptr) {
+            if (!thread->m_async_result->IsComplete()) {
+                return false;
+            }
+
+            thread->m_regs[0] = thread->m_async_result->GetValue();
+            thread->m_async_result.Reset();
+        }
+
+        m_state.Safepoint();
+    }
+
+    return true;
+}
+
+void VM::WaitForAsyncResult(ExecutionThread *thread)
+{
+    // how long to wait between safepoints, so collections requested by other threads are not held up
+    static constexpr std::chrono::microseconds safepoint_interval(1000);
+
+    AssertThrow(thread->m_async_result != nullptr);
+
+    while (!thread->m_async_result->WaitFor(safepoint_interval)) {
+        m_state.Safepoint();
+    }
+
+    thread->m_regs[0] = thread->m_async_result->GetValue();
+    thread->m_async_result.Reset();
 }
 
 void VM::CreateStackTrace(ExecutionThread *thread, StackTrace *out)
@@ -1317,67 +1694,125 @@ void VM::CreateStackTrace(ExecutionThread *thread, StackTrace *out)
     }
 }
 
-bool VM::HandleException(InstructionHandler *handler)
+bool VM::HandleException(
+    InstructionHandler *handler,
+    UInt base_function_depth,
+    Bool search_base_frame
+)
 {
     ExecutionThread *thread = handler->thread;
     BytecodeStream *bs = handler->bs;
+    StackMemory &stack = thread->m_stack;
+
+    AssertThrow(thread->m_exception_state.m_exception_depth != 0);
+
+    // nothing is popped until a handler has been found, so the stack is intact for the trace
+    // if there is none. address is the position after the instruction that threw, or after
+    // the call instruction of each frame further down.
+    BCAddress address = static_cast<BCAddress>(bs->Position());
+    SizeType sp = stack.GetStackPointer();
+    UInt function_depth = thread->m_func_depth;
 
-    if (thread->m_exception_state.m_try_counter != 0) {
-        // handle exception
-        --thread->m_exception_state.m_try_counter;
+    while (function_depth > base_function_depth || search_base_frame) {
+        // the frame starts just above its FUNCTION_CALL value, top level code at the bottom of the stack
+        SizeType call_index = SizeType(-1);
+        SizeType frame_base = 0;
 
-        AssertThrow(thread->m_exception_state.m_exception_depth != 0);
-        --thread->m_exception_state.m_exception_depth;
+        if (function_depth != 0) {
+            for (SizeType index = sp; index != 0; index--) {
+                if (stack[index - 1].m_type == Value::FUNCTION_CALL) {
+                    call_index = index - 1;
+                    frame_base = index;
 
-        Value *top = nullptr;
-        while ((top = &thread->m_stack.Top()) && top->m_type != Value::TRY_CATCH_INFO) {
-            thread->m_stack.Pop();
+                    break;
+                }
+            }
+
+            AssertThrowMsg(call_index != SizeType(-1), "No stack frame found for function depth %u", function_depth);
         }
 
-        // top should be exception data
-        AssertThrow(top != nullptr && top->m_type == Value::TRY_CATCH_INFO);
+        const RC<Program> &program = bs->GetProgram();
 
-        // jump to the catch block
-        bs->Seek(top->m_value.try_catch_info.catch_address);
+        if (const ExceptionTableEntry *entry = program != nullptr ? program->GetExceptionTable().FindHandler(address) : nullptr) {
+            const SizeType catch_sp = frame_base + entry->stack_depth;
+            AssertThrow(catch_sp <= stack.GetStackPointer());
 
-        // pop exception data from stack
-        thread->m_stack.Pop();
+            // unwind everything above the try block, including the frames of any functions it called
+            stack.Pop(stack.GetStackPointer() - catch_sp);
 
-        return true;
-    } else {
-        StackTrace stack_trace;
-        CreateStackTrace(thread, &stack_trace);
+            thread->m_func_depth = function_depth;
+            --thread->m_exception_state.m_exception_depth;
 
-        std::cout << "stack_trace = \n";
+            // any generators resumed within the try block have been unwound
+            thread->UnwindGeneratorFrames();
 
-        for (auto call_address : stack_trace.call_addresses) {
-            if (call_address == -1) {
-                break;
-            }
-            
-            std::cout << "\t" << std::hex << call_address << "\n";
+            // jump to the catch block
+            bs->Seek(entry->catch_address);
+
+            return true;
         }
 
-        std::cout << "=====\n";
+        if (function_depth <= base_function_depth) {
+            break;
+        }
+
+        // not caught in this function, continue from where it was called
+        address = stack[call_index].m_value.call.return_address;
+        sp = call_index;
+        --function_depth;
+    }
 
-        // TODO: Seek outside function, if calling from outside?
-        // so we can keep calling
+    // exception cannot be handled, no try block found
+    if (thread->m_id == 0) {
+        utf::printf(HYP_UTF8_CSTR("unhandled exception in main thread: %" PRIutf8s "\n"),
+            HYP_UTF8_TOWIDE(thread->m_exception_state.m_message.Data()));
+    } else {
+        utf::printf(HYP_UTF8_CSTR("unhandled exception in thread #%d: %" PRIutf8s "\n"),
+            thread->m_id + 1, HYP_UTF8_TOWIDE(thread->m_exception_state.m_message.Data()));
     }
 
+    m_state.good = false;
+
+    StackTrace stack_trace;
+    CreateStackTrace(thread, &stack_trace);
+
+    std::cout << "stack_trace = \n";
+
+    for (auto call_address : stack_trace.call_addresses) {
+        if (call_address == -1) {
+            break;
+        }
+        
+        std::cout << "\t" << std::hex << call_address << "\n";
+    }
+
+    std::cout << "=====\n";
+
     return false;
 }
 
 void VM::Execute(BytecodeStream *bs)
 {
-    AssertThrow(bs != nullptr);
     AssertThrow(m_state.GetNumThreads() != 0);
 
+    Execute(bs, m_state.MAIN_THREAD);
+}
+
+void VM::Execute(BytecodeStream *bs, ExecutionThread *thread)
+{
+    AssertThrow(bs != nullptr);
+    AssertThrow(thread != nullptr);
+
+    ExecutionScope execution_scope(m_state, thread);
+
     InstructionHandler handler(
         &m_state,
-        m_state.MAIN_THREAD,
+        thread,
         bs
     );
 
+    const UInt original_function_depth = thread->m_func_depth;
+
     UByte code;
 
     while (!bs->Eof()) {
@@ -1390,16 +1825,220 @@ void VM::Execute(BytecodeStream *bs)
         );
 
         if (handler.thread->GetExceptionState().HasExceptionOccurred()) {
-            HandleException(&handler);
-
-            if (!handler.state->good) {
+            if (!HandleException(&handler, original_function_depth, true)) {
                 DebugLog(LogType::Error, "Unhandled exception in VM, stopping execution...\n");
 
                 break;
             }
         }
+
+        m_state.Safepoint();
     }
 }
 
+void VM::BeginExecute(
+    BytecodeStream *bs,
+    ExecutionThread *thread,
+    Continuation &out_continuation
+)
+{
+    AssertThrow(bs != nullptr);
+    AssertThrow(thread != nullptr);
+
+    out_continuation = Continuation {
+        .thread                     = thread,
+        .position                   = bs->Position(),
+        .original_function_depth    = thread->m_func_depth,
+        .stack_size_before          = thread->GetStack().GetStackPointer(),
+        .run_to_eof                 = true,
+        .is_done                    = bs->Eof()
+    };
+}
+
+void VM::BeginInvoke(
+    BytecodeStream *bs,
+    const Value &value,
+    const Value *args,
+    UInt8 nargs,
+    ExecutionThread *thread,
+    Continuation &out_continuation
+)
+{
+    AssertThrow(bs != nullptr);
+    AssertThrow(thread != nullptr);
+    AssertThrow(nargs == 0 || args != nullptr);
+
+    ExecutionScope execution_scope(m_state, thread);
+
+    const SizeType position_before = bs->Position();
+
+    out_continuation = Continuation {
+        .thread                     = thread,
+        .position                   = position_before,
+        .original_function_depth    = thread->m_func_depth,
+        .stack_size_before          = thread->GetStack().GetStackPointer(),
+        .run_to_eof                 = false,
+        .is_done                    = false
+    };
+
+    for (UInt8 i = 0; i < nargs; i++) {
+        thread->GetStack().Push(args[i]);
+    }
+
+    InstructionHandler handler(
+        &m_state,
+        thread,
+        bs
+    );
+
+    Invoke(
+        &handler,
+        value,
+        nargs
+    );
+
+    if (thread->m_func_depth == out_continuation.original_function_depth || thread->GetExceptionState().HasExceptionOccurred()) {
+        // native function has already run, or the call could not be made
+        thread->m_exception_state.m_exception_depth = 0;
+        thread->GetStack().Pop(thread->GetStack().GetStackPointer() - out_continuation.stack_size_before);
+
+        out_continuation.is_done = true;
+    } else {
+        // invoke seeked to the start of the function
+        out_continuation.position = bs->Position();
+    }
+
+    bs->SetPosition(position_before);
+}
+
+ExecutionStatus VM::Resume(
+    BytecodeStream *bs,
+    Continuation &continuation,
+    const ExecutionBudget &budget
+)
+{
+    // how many instructions to run between checks of the clock
+    static constexpr UInt64 time_check_interval = 256;
+
+    AssertThrow(bs != nullptr);
+    AssertThrow(continuation.thread != nullptr);
+
+    if (continuation.is_done) {
+        return ExecutionStatus::COMPLETED;
+    }
+
+    ExecutionThread *thread = continuation.thread;
+
+    ExecutionScope execution_scope(m_state, thread, true);
+
+    const SizeType position_before = bs->Position();
+    bs->SetPosition(continuation.position);
+
+    InstructionHandler handler(
+        &m_state,
+        thread,
+        bs
+    );
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budget.max_microseconds);
+
+    ExecutionStatus status = ExecutionStatus::COMPLETED;
+    UInt64 num_instructions = 0;
+    UByte code;
+
+    while (!bs->Eof()) {
+        if (thread->m_async_result != nullptr) {
+            if (!thread->m_async_result->IsComplete()) {
+                status = ExecutionStatus::WAITING;
+
+                break;
+            }
+
+            // deliver the result of the async native call, as if it had returned it
+            thread->m_regs[0] = thread->m_async_result->GetValue();
+            thread->m_async_result.Reset();
+        }
+
+        if (budget.max_instructions != 0 && num_instructions >= budget.max_instructions) {
+            status = ExecutionStatus::SUSPENDED;
+
+            break;
+        }
+
+        if (budget.max_microseconds != 0 && num_instructions % time_check_interval == time_check_interval - 1) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                status = ExecutionStatus::SUSPENDED;
+
+                break;
+            }
+        }
+
+        bs->Read(&code);
+
+        HandleInstruction(
+            handler,
+            bs,
+            code
+        );
+
+        ++num_instructions;
+
+        if (thread->GetExceptionState().HasExceptionOccurred()) {
+            if (!HandleException(&handler, continuation.original_function_depth, continuation.run_to_eof)) {
+                if (continuation.run_to_eof) {
+                    if (!m_state.good) {
+                        DebugLog(LogType::Error, "Unhandled exception in VM, stopping execution...\n");
+
+                        break;
+                    }
+                } else {
+                    thread->m_exception_state.m_exception_depth = 0;
+                    thread->m_func_depth = continuation.original_function_depth;
+
+                    break;
+                }
+            }
+        }
+
+        if (!continuation.run_to_eof && code == RET) {
+            if (thread->m_func_depth == continuation.original_function_depth) {
+                break;
+            }
+        }
+
+        m_state.Safepoint();
+    }
+
+    if (status == ExecutionStatus::COMPLETED && thread->m_async_result != nullptr) {
+        // the async native call was the last thing to run
+        if (thread->m_async_result->IsComplete()) {
+            thread->m_regs[0] = thread->m_async_result->GetValue();
+            thread->m_async_result.Reset();
+        } else {
+            status = ExecutionStatus::WAITING;
+        }
+    }
+
+    if (status != ExecutionStatus::COMPLETED) {
+        continuation.position = bs->Position();
+    } else {
+        continuation.is_done = true;
+
+        if (!continuation.run_to_eof) {
+            // pop the arguments pushed by BeginInvoke()
+            AssertThrow(thread->GetStack().GetStackPointer() >= continuation.stack_size_before);
+            thread->GetStack().Pop(thread->GetStack().GetStackPointer() - continuation.stack_size_before);
+
+            thread->UnwindGeneratorFrames();
+        }
+    }
+
+    if (!continuation.run_to_eof) {
+        bs->SetPosition(position_before);
+    }
+
+    return status;
+}
+
 } // namespace vm
 } // namespace hyperion
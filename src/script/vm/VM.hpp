@@ -23,10 +23,36 @@ class APIInstance;
 
 namespace vm {
 
+struct ExecutionBudget
+{
+    UInt64  max_instructions = 0; // 0 for no limit
+    UInt64  max_microseconds = 0; // 0 for no limit
+};
+
+enum class ExecutionStatus : UInt8
+{
+    COMPLETED,
+    SUSPENDED,
+    WAITING     // parked on an async native call; resume once its AsyncResult has completed
+};
+
+/*! \brief Where a budgeted execution left off. The stack and registers stay on
+    the thread, so the thread must not run anything else until the continuation
+    has completed. */
+struct Continuation
+{
+    ExecutionThread *thread = nullptr;
+    SizeType        position = 0;
+    UInt            original_function_depth = 0;
+    SizeType        stack_size_before = 0;
+    Bool            run_to_eof = false; // else, run until the invoked function returns
+    Bool            is_done = true;
+};
+
 class VM
 {
 public:
-    VM(APIInstance &api_instance);
+    VM(APIInstance &api_instance, SizeType num_static_objects = StaticMemory::static_size);
     VM(const VM &other) = delete;
     VM &operator=(const VM &other) = delete;
     VM(VM &&other) noexcept = delete;
@@ -47,16 +73,116 @@ public:
         UInt8 nargs
     );
 
+    /*! \brief Call a native function with the top \ref{nargs} values of the stack as its arguments.
+        No frame is pushed; the result is left in register 0. */
+    void InvokeNative(
+        InstructionHandler *handler,
+        NativeFunctionPtr_t native_func,
+        UInt8 nargs
+    );
+
+    /*! \brief Invoke a function on the main thread and run it to completion.
+        Blocks while the function waits on an async native function. */
     void InvokeNow(
         BytecodeStream *bs,
         const Value &value,
         UInt8 nargs
     );
 
+    /*! \brief Invoke a function on the given thread and run it to completion.
+        Any number of threads may be invoking concurrently from different host
+        threads, as long as each uses its own BytecodeStream.
+        Blocks while the function waits on an async native function. */
+    void InvokeNow(
+        BytecodeStream *bs,
+        const Value &value,
+        UInt8 nargs,
+        ExecutionThread *thread
+    );
+
+    /*! \brief Invoke a function \ref count times on the given thread, entering
+        the VM only once. Each call takes the next \ref nargs values from \ref args,
+        and register 0 after each call is written to \ref results_out, if given.
+        If \ref out_parked is given, a call that waits on an async native function is
+        parked instead of blocking the host thread: the batch stops, the rest of that call
+        is written to \ref out_parked to be run with Resume(), and the number of calls that
+        completed before it is returned. Otherwise (or if nothing parks) returns \ref count. */
+    SizeType InvokeBatch(
+        BytecodeStream *bs,
+        const Value &value,
+        UInt8 nargs,
+        const Value *args,
+        SizeType count,
+        Value *results_out,
+        ExecutionThread *thread,
+        Continuation *out_parked = nullptr
+    );
+
     void Execute(BytecodeStream *bs);
+    void Execute(BytecodeStream *bs, ExecutionThread *thread);
+
+    /*! \brief Prepare to execute from the stream's current position to the end,
+        without running anything yet. Run it with Resume(). */
+    void BeginExecute(
+        BytecodeStream *bs,
+        ExecutionThread *thread,
+        Continuation &out_continuation
+    );
+
+    /*! \brief Push the arguments and invoke a function, without running its body yet.
+        Run it with Resume(). Native functions are run immediately. */
+    void BeginInvoke(
+        BytecodeStream *bs,
+        const Value &value,
+        const Value *args,
+        UInt8 nargs,
+        ExecutionThread *thread,
+        Continuation &out_continuation
+    );
+
+    /*! \brief Continue running until the continuation completes or the budget is
+        used up, whichever comes first. The time budget is checked every
+        few hundred instructions. If an async native function is called, returns
+        WAITING until its result has been completed, instead of blocking. */
+    ExecutionStatus Resume(
+        BytecodeStream *bs,
+        Continuation &continuation,
+        const ExecutionBudget &budget
+    );
 
 private:
-    bool HandleException(InstructionHandler *handler);
+    void CreateGenerator(
+        InstructionHandler *handler,
+        const Value &value,
+        UInt8 nargs
+    );
+
+    void ResumeGenerator(
+        InstructionHandler *handler,
+        HeapValue *generator_ptr,
+        UInt8 nargs
+    );
+
+    /*! \brief Returns false if the thread was parked on an async native call
+        before the function returned. Only possible if the thread can park. */
+    bool RunUntilReturn(
+        InstructionHandler *handler,
+        UInt original_function_depth,
+        SizeType stack_size_before
+    );
+
+    void WaitForAsyncResult(ExecutionThread *thread);
+
+    /*! \brief Search the exception table for a try block covering the current
+        position, then each call site below it down to \ref base_function_depth,
+        and unwind the stack to the first one found. The frame at the base depth
+        is only searched if \ref search_base_frame is set, i.e. it is script code
+        rather than a call from the host. */
+    bool HandleException(
+        InstructionHandler *handler,
+        UInt base_function_depth,
+        Bool search_base_frame
+    );
     void CreateStackTrace(ExecutionThread *thread, StackTrace *out);
 
     APIInstance     &m_api_instance;
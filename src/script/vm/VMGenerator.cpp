@@ -0,0 +1,15 @@
+#include <script/vm/VMGenerator.hpp>
+
+namespace hyperion {
+namespace vm {
+
+VMGenerator::VMGenerator(BCAddress resume_address, UInt8 num_args)
+    : m_resume_address(resume_address),
+      m_num_args(num_args),
+      m_is_running(false),
+      m_is_done(false)
+{
+}
+
+} // namespace vm
+} // namespace hyperion
@@ -0,0 +1,68 @@
+#ifndef VM_GENERATOR_HPP
+#define VM_GENERATOR_HPP
+
+#include <core/lib/DynArray.hpp>
+#include <script/vm/Value.hpp>
+
+#include <Types.hpp>
+
+namespace hyperion {
+namespace vm {
+
+/*! \brief A suspended call to a generator function. Only the frame of the
+    generator itself (its arguments and locals) is saved between resumes,
+    never the rest of the stack. */
+class VMGenerator
+{
+public:
+    VMGenerator(BCAddress resume_address, UInt8 num_args);
+    VMGenerator(const VMGenerator &other)                   = default;
+    VMGenerator &operator=(const VMGenerator &other)        = default;
+    VMGenerator(VMGenerator &&other) noexcept               = default;
+    VMGenerator &operator=(VMGenerator &&other) noexcept    = default;
+    ~VMGenerator()                                          = default;
+
+    bool operator==(const VMGenerator &other) const
+        { return this == &other; }
+
+    BCAddress GetResumeAddress() const
+        { return m_resume_address; }
+
+    void SetResumeAddress(BCAddress resume_address)
+        { m_resume_address = resume_address; }
+
+    UInt8 GetNumArgs() const
+        { return m_num_args; }
+
+    /*! \brief The saved frame: arguments first, followed by the locals that were on
+        the stack above the call frame when the generator last yielded. */
+    Array<Value> &GetFrame()
+        { return m_frame; }
+
+    const Array<Value> &GetFrame() const
+        { return m_frame; }
+
+    Bool IsRunning() const
+        { return m_is_running; }
+
+    void SetIsRunning(Bool is_running)
+        { m_is_running = is_running; }
+
+    Bool IsDone() const
+        { return m_is_done; }
+
+    void SetIsDone(Bool is_done)
+        { m_is_done = is_done; }
+
+private:
+    BCAddress       m_resume_address;
+    UInt8           m_num_args;
+    Array<Value>    m_frame;
+    Bool            m_is_running;
+    Bool            m_is_done;
+};
+
+} // namespace vm
+} // namespace hyperion
+
+#endif
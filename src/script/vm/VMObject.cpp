@@ -12,6 +12,7 @@ namespace vm {
 
 const UInt32 VMObject::PROTO_MEMBER_HASH = hash_fnv_1("$proto");
 const UInt32 VMObject::BASE_MEMBER_HASH = hash_fnv_1("base");
+const UInt32 VMObject::INTERN_MEMBER_HASH = hash_fnv_1("__intern");
 
 ObjectMap::ObjectBucket::ObjectBucket()
     : m_data(new Member*[DEFAULT_BUCKET_CAPACITY]),
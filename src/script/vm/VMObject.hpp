@@ -65,6 +65,7 @@ class VMObject
 public:
     static const UInt32 PROTO_MEMBER_HASH;
     static const UInt32 BASE_MEMBER_HASH;
+    static const UInt32 INTERN_MEMBER_HASH;
 
     // construct from prototype (holds pointer)
     VMObject(HeapValue *class_ptr);
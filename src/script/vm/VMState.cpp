@@ -1,4 +1,5 @@
 #include <script/vm/VMState.hpp>
+#include <script/vm/VMGenerator.hpp>
 
 #include <util/UTF8.hpp>
 
@@ -11,7 +12,30 @@
 namespace hyperion {
 namespace vm {
 
-VMState::VMState()
+void ExecutionThread::UnwindGeneratorFrames()
+{
+    while (m_generator_frames.Any() && m_generator_frames.Back().call_index >= m_stack.GetStackPointer()) {
+        if (VMGenerator *generator = m_generator_frames.Back().generator->GetPointer<VMGenerator>()) {
+            generator->SetIsRunning(false);
+            generator->SetIsDone(true);
+            generator->GetFrame().Clear();
+        }
+
+        m_generator_frames.PopBack();
+    }
+}
+
+RC<AsyncResult> ExecutionThread::BeginAsync()
+{
+    AssertThrowMsg(m_async_result == nullptr, "Only one async call may be pending on a thread at a time");
+
+    m_async_result.Reset(new AsyncResult());
+
+    return m_async_result;
+}
+
+VMState::VMState(SizeType num_static_objects)
+    : m_static_memory(num_static_objects)
 {
     for (int i = 0; i < VM_MAX_THREADS; i++) {
         m_threads[i] = nullptr;
@@ -32,6 +56,8 @@ void VMState::Reset()
     m_heap.Purge();
     // reset heap threshold
     m_max_heap_objects = GC_THRESHOLD_MIN;
+    // bound again by the next Run()
+    m_native_functions.Clear();
 
     for (UInt i = 0; i < VM_MAX_THREADS; i++) {
         DestroyThread(i);
@@ -45,27 +71,25 @@ void VMState::ThrowException(ExecutionThread *thread, const Exception &exception
 {
     ++thread->m_exception_state.m_exception_depth;
 
-    if (thread->m_exception_state.m_try_counter == 0) {
-        // exception cannot be handled, no try block found
-        if (thread->m_id == 0) {
-            utf::printf(HYP_UTF8_CSTR("unhandled exception in main thread: %" PRIutf8s "\n"),
-                HYP_UTF8_TOWIDE(exception.ToString()));
-        } else {
-            utf::printf(HYP_UTF8_CSTR("unhandled exception in thread #%d: %" PRIutf8s "\n"),
-                thread->m_id + 1, HYP_UTF8_TOWIDE(exception.ToString()));
-        }
-
-        good = false;
-    }
+    // whether anything catches it is only known once the exception table has been searched
+    thread->m_exception_state.m_message = exception.ToString();
 }
 
 HeapValue *VMState::HeapAlloc(ExecutionThread *thread)
 {
     AssertThrow(thread != nullptr);
 
-    const SizeType heap_size = m_heap.Size();
+    SizeType heap_size;
+    int max_heap_objects;
+
+    {
+        Mutex::Guard guard(m_heap_mutex);
+
+        heap_size = m_heap.Size();
+        max_heap_objects = m_max_heap_objects;
+    }
         
-    if (heap_size >= m_max_heap_objects) {
+    if (heap_size >= max_heap_objects) {
         if (heap_size >= GC_THRESHOLD_MAX) {
             // heap overflow.
             char buffer[256];
@@ -82,10 +106,14 @@ HeapValue *VMState::HeapAlloc(ExecutionThread *thread)
         }
 
 #if ENABLE_GC
-        if (enable_auto_gc) {
+        // only a cheap early-out: another thread may begin a native call right after
+        // this check, so GC() checks again once every other thread has stopped
+        if (enable_auto_gc && m_num_native_calls.load(std::memory_order_acquire) == 0) {
             // run the gc
             GC();
 
+            Mutex::Guard guard(m_heap_mutex);
+
             // check if size is still over the maximum,
             // and resize the maximum if necessary.
             if (m_heap.Size() >= m_max_heap_objects) {
@@ -99,41 +127,169 @@ HeapValue *VMState::HeapAlloc(ExecutionThread *thread)
 #endif
     }
 
+    Mutex::Guard guard(m_heap_mutex);
+
     return m_heap.Alloc();
 }
 
 void VMState::GC()
 {
+    bool expected = false;
+
+    if (!m_gc_requested.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        // another thread is already collecting
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_safepoint_mutex);
+
+    // wait for all other threads executing bytecode to park at a safepoint.
+    // if this host thread is executing bytecode itself, it is counted as well.
+    const UInt num_self_executing = IsExecutingOnCurrentThread() ? 1 : 0;
+
+    m_safepoint_cv.wait(lock, [this, num_self_executing]
+    {
+        return m_num_executing_threads == num_self_executing;
+    });
+
+    // every other thread is now parked or outside of the VM, so no native call can
+    // begin until the collection has finished. one that is still running (e.g. a native
+    // function that called back into the script, and is parked in the nested call) may
+    // hold values that are not reachable from any stack, so don't collect at all.
+    if (m_num_native_calls.load(std::memory_order_acquire) != 0) {
+        m_gc_requested.store(false, std::memory_order_release);
+
+        lock.unlock();
+        m_safepoint_cv.notify_all();
+
+        return;
+    }
+
     DebugLog(
         LogType::Debug,
         "Begin gc\n"
     );
 
-    m_exported_symbols.MarkAll();
+    UInt num_collected;
 
-    // mark stack objects on each thread
-    for (UInt i = 0; i < VM_MAX_THREADS; i++) {
-        if (m_threads[i] != nullptr) {
-            m_threads[i]->m_stack.MarkAll();
+    {
+        Mutex::Guard threads_guard(m_threads_mutex);
+        Mutex::Guard heap_guard(m_heap_mutex);
 
-            for (UInt j = 0; j < VM_NUM_REGISTERS; j++) {
-                m_threads[i]->GetRegisters()[j].Mark();
+        m_exported_symbols.MarkAll();
+
+        // mark stack objects on each thread
+        for (UInt i = 0; i < VM_MAX_THREADS; i++) {
+            if (m_threads[i] != nullptr) {
+                m_threads[i]->m_stack.MarkAll();
+
+                for (UInt j = 0; j < VM_NUM_REGISTERS; j++) {
+                    m_threads[i]->GetRegisters()[j].Mark();
+                }
             }
         }
-    }
 
-    UInt num_collected;
-    m_heap.Sweep(&num_collected);
+        m_heap.Sweep(&num_collected);
+    }
 
     DebugLog(
         LogType::Debug,
         "%u objects garbage collected\n",
         num_collected
     );
+
+    m_gc_requested.store(false, std::memory_order_release);
+
+    lock.unlock();
+    m_safepoint_cv.notify_all();
+}
+
+void VMState::EnterExecution(ExecutionThread *thread)
+{
+    AssertThrow(thread != nullptr);
+
+    std::unique_lock<std::mutex> lock(m_safepoint_mutex);
+
+    if (thread->m_execution_depth++ != 0) {
+        // re-entering from a native function; already counted as executing.
+        AssertThrow(thread->m_host_thread_id == std::this_thread::get_id());
+
+        return;
+    }
+
+    // don't start executing in the middle of a collection
+    m_safepoint_cv.wait(lock, [this]
+    {
+        return !m_gc_requested.load(std::memory_order_acquire);
+    });
+
+    thread->m_host_thread_id = std::this_thread::get_id();
+    ++m_num_executing_threads;
+}
+
+void VMState::LeaveExecution(ExecutionThread *thread)
+{
+    AssertThrow(thread != nullptr);
+
+    std::unique_lock<std::mutex> lock(m_safepoint_mutex);
+
+    AssertThrow(thread->m_execution_depth != 0);
+
+    if (--thread->m_execution_depth != 0) {
+        return;
+    }
+
+    thread->m_host_thread_id = std::thread::id();
+
+    AssertThrow(m_num_executing_threads != 0);
+    --m_num_executing_threads;
+
+    lock.unlock();
+    m_safepoint_cv.notify_all();
+}
+
+void VMState::ParkAtSafepoint()
+{
+    std::unique_lock<std::mutex> lock(m_safepoint_mutex);
+
+    if (!m_gc_requested.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    AssertThrow(m_num_executing_threads != 0);
+    --m_num_executing_threads;
+
+    m_safepoint_cv.notify_all();
+
+    m_safepoint_cv.wait(lock, [this]
+    {
+        return !m_gc_requested.load(std::memory_order_acquire);
+    });
+
+    ++m_num_executing_threads;
+}
+
+bool VMState::IsExecutingOnCurrentThread()
+{
+    Mutex::Guard guard(m_threads_mutex);
+
+    const std::thread::id current_thread_id = std::this_thread::get_id();
+
+    for (UInt i = 0; i < VM_MAX_THREADS; i++) {
+        const ExecutionThread *thread = m_threads[i];
+
+        if (thread != nullptr && thread->m_execution_depth != 0 && thread->m_host_thread_id == current_thread_id) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 ExecutionThread *VMState::CreateThread()
 {
+    Mutex::Guard guard(m_threads_mutex);
+
     AssertThrow(m_num_threads < VM_MAX_THREADS);
 
     // find a free slot
@@ -156,15 +312,21 @@ void VMState::DestroyThread(int id)
 {
     AssertThrow(id < VM_MAX_THREADS);
 
+    Mutex::Guard guard(m_threads_mutex);
+
     ExecutionThread *thread = m_threads[id];
 
     if (thread != nullptr) {
+        AssertThrowMsg(thread->m_execution_depth == 0, "Cannot destroy thread #%d while it is executing", id);
+
         // purge the stack
         thread->m_stack.Purge();
         // reset exception state
         thread->m_exception_state = { };
         // reset register flags
         thread->m_regs.ResetFlags();
+        // finish any generators left running on the thread
+        thread->UnwindGeneratorFrames();
 
         // delete it
         delete m_threads[id];
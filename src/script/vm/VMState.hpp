@@ -8,6 +8,8 @@
 #include <core/lib/FlatMap.hpp>
 #include <core/lib/HeapArray.hpp>
 #include <core/lib/ValueStorage.hpp>
+#include <core/lib/Mutex.hpp>
+#include <core/lib/String.hpp>
 
 #include <script/vm/StackMemory.hpp>
 #include <script/vm/StaticMemory.hpp>
@@ -16,18 +18,23 @@
 #include <script/vm/BytecodeStream.hpp>
 #include <script/vm/Tracemap.hpp>
 #include <script/vm/ExportedSymbolTable.hpp>
+#include <script/vm/AsyncResult.hpp>
 
 #include <Types.hpp>
 
 #include <util/NonOwningPtr.hpp>
+#include <util/Defines.hpp>
 
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #define ENABLE_GC 1
 #define GC_THRESHOLD_MIN 150
 #define GC_THRESHOLD_MAX 50000
 
-#define VM_MAX_THREADS 1//8
+#define VM_MAX_THREADS 8
 #define VM_NUM_REGISTERS 8
 
 namespace hyperion {
@@ -47,17 +54,23 @@ struct Registers
 
 struct ExceptionState
 {
-    // incremented each time BEGIN_TRY is encountered,
-    // decremented each time END_TRY is encountered
-    UInt m_try_counter = 0;
-
-    // set to true when an exception occurs,
-    // set to false when handled in BEGIN_TRY
+    // incremented when an exception occurs,
+    // decremented when it is caught
     UInt m_exception_depth = 0;
 
+    // message of the most recent exception, reported if nothing catches it
+    String m_message;
+
     bool HasExceptionOccurred() const { return m_exception_depth != 0; }
 };
 
+struct GeneratorFrame
+{
+    HeapValue   *generator;
+    // stack index of the FUNCTION_CALL value of the resumed generator's frame
+    SizeType    call_index;
+};
+
 struct ExecutionThread
 {
     friend struct VMState;
@@ -69,6 +82,20 @@ struct ExecutionThread
     UInt            m_func_depth = 0;
     int             m_id = -1;
 
+    // number of nested VM entries (Execute / InvokeNow) currently active on this thread,
+    // and the host thread running them. guarded by VMState's safepoint mutex.
+    UInt            m_execution_depth = 0;
+    std::thread::id m_host_thread_id;
+
+    // generators currently resumed on this thread, innermost last
+    Array<GeneratorFrame> m_generator_frames;
+
+    // set by an async native function until its result has been delivered to register 0
+    RC<AsyncResult> m_async_result;
+    // true while running under a Continuation, which can be parked on an async result.
+    // otherwise an async native call blocks until its result is completed.
+    Bool            m_can_park = false;
+
     StackMemory &GetStack()
         { return m_stack; }
 
@@ -77,6 +104,15 @@ struct ExecutionThread
 
     Registers &GetRegisters()
         { return m_regs; }
+
+    /*! \brief Finish any resumed generators whose frames have been popped off
+        the stack, e.g. by an exception unwinding past them. */
+    void UnwindGeneratorFrames();
+
+    /*! \brief Called by a native function to return its result asynchronously.
+        The native returns without setting register 0, and the calling script
+        does not continue until the returned AsyncResult has been completed. */
+    RC<AsyncResult> BeginAsync();
 };
 
 struct DynModule
@@ -86,7 +122,7 @@ struct DynModule
 
 struct VMState
 {
-    VMState();
+    VMState(SizeType num_static_objects = StaticMemory::static_size);
     VMState(const VMState &other) = delete;
     ~VMState();
 
@@ -97,8 +133,10 @@ struct VMState
     Tracemap                            m_tracemap;
     ExportedSymbolTable                 m_exported_symbols;
     FlatMap<UInt32, Weak<DynModule>>    m_dyn_modules;
+    // native functions called directly by CALL_NATIVE, filled in when the script API is bound
+    Array<NativeFunctionPtr_t>          m_native_functions;
 
-    bool                                good = true;
+    std::atomic_bool                    good { true };
     bool                                enable_auto_gc = ENABLE_GC;
     int                                 m_max_heap_objects = GC_THRESHOLD_MIN;
 
@@ -109,8 +147,38 @@ struct VMState
 
     void ThrowException(ExecutionThread *thread, const Exception &exception);
     HeapValue *HeapAlloc(ExecutionThread *thread);
+
+    /** Run a garbage collection. Waits for every other thread that is executing
+        bytecode to park at a safepoint first. If a collection has already been
+        requested by another thread, or any thread is inside of a native function
+        once the others have parked, returns without collecting.
+     */
     void GC();
 
+    /** Must be called by a host thread before it starts executing bytecode on
+        the given ExecutionThread, and paired with LeaveExecution(). Blocks while
+        a garbage collection is in progress. Nested calls are allowed.
+     */
+    void EnterExecution(ExecutionThread *thread);
+    void LeaveExecution(ExecutionThread *thread);
+
+    /** Called at instruction boundaries. If a garbage collection has been
+        requested by another thread, park until it has finished. */
+    HYP_FORCE_INLINE void Safepoint()
+    {
+        if (m_gc_requested.load(std::memory_order_acquire)) {
+            ParkAtSafepoint();
+        }
+    }
+
+    /** No collections are started while any thread is inside of a native
+        function, as it may hold values not reachable from any stack. */
+    HYP_FORCE_INLINE void BeginNativeCall()
+        { m_num_native_calls.fetch_add(1, std::memory_order_acq_rel); }
+
+    HYP_FORCE_INLINE void EndNativeCall()
+        { m_num_native_calls.fetch_sub(1, std::memory_order_acq_rel); }
+
     // void CloneValue(const Value &other, ExecutionThread *thread, Value &out);
 
     /** Add a thread */
@@ -138,7 +206,18 @@ struct VMState
         { return m_exported_symbols; }
 
 private:
-    SizeType m_num_threads = 0;
+    void ParkAtSafepoint();
+    bool IsExecutingOnCurrentThread();
+
+    SizeType                            m_num_threads = 0;
+    Mutex                               m_threads_mutex;
+    Mutex                               m_heap_mutex;
+
+    std::mutex                          m_safepoint_mutex;
+    std::condition_variable             m_safepoint_cv;
+    std::atomic_bool                    m_gc_requested { false };
+    UInt                                m_num_executing_threads = 0;
+    std::atomic<UInt>                   m_num_native_calls { 0 };
 };
 
 } // namespace vm
@@ -5,6 +5,7 @@
 #include <script/vm/VMArraySlice.hpp>
 #include <script/vm/VMString.hpp>
 #include <script/vm/VMMap.hpp>
+#include <script/vm/VMGenerator.hpp>
 #include <script/vm/HeapValue.hpp>
 #include <script/Hasher.hpp>
 
@@ -267,6 +268,8 @@ const char *Value::GetTypeString() const
             return "MemoryBuffer";
         } else if (m_value.ptr->GetPointer<VMStruct>()) {
             return "Struct";
+        } else if (m_value.ptr->GetPointer<VMGenerator>()) {
+            return "Generator";
         } else if (VMObject *object = m_value.ptr->GetPointer<VMObject>()) {
             return "Object"; // TODO prototype name
         }
@@ -277,7 +280,6 @@ const char *Value::GetTypeString() const
     case NATIVE_FUNCTION: return "Function";
     case ADDRESS: return "<Function address>";
     case FUNCTION_CALL: return "<Stack frame>";
-    case TRY_CATCH_INFO: return "<Try catch info>";
     case USER_DATA: return "UserData";
     default: return "<Invalid type>";
     }